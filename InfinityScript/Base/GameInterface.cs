@@ -16,6 +16,17 @@ namespace InfinityScript
         Integer = 6
     }
 
+    // a field value for Script_SetFields, laid out like GI_FieldUpdate; floats use vector.X, strings index the strings array
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct FieldUpdate
+    {
+        public int entRef;
+        public int fieldID;
+        public VariableType type;
+        public int integer;
+        public Vector3 vector;
+    }
+
     static class GameInterface
     {
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
@@ -75,6 +86,9 @@ namespace InfinityScript
         [DllImport("iw5m.dll", EntryPoint = "GI_SetField")]
         public static extern int Script_SetField(int entref, int field);
 
+        [DllImport("iw5m.dll", EntryPoint = "GI_SetFields")]
+        public static extern void Script_SetFields(int count, FieldUpdate[] updates, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] string[] strings);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern void Script_NotifyNum(int entref, string notify, int numArgs);
 
@@ -102,12 +116,49 @@ namespace InfinityScript
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern string Cmd_Argv_sv(int arg);
 
+        // all arguments in a single call, instead of Cmd_Argc and a Cmd_Argv per argument
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern string[] Cmd_Args();
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern string[] Cmd_Args_sv();
+
+        // the game only passes the commands we subscribed to
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern void Cmd_Subscribe(string command);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern void Cmd_Subscribe_sv(string command);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern void Cbuf_AddText(string command);
 
+        // JIT-compiles a method ahead of its first call, takes a RuntimeMethodHandle value
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern void CompileMethod(IntPtr method);
+
         [DllImport("iw5m.dll", EntryPoint = "GI_GetPing")]
         public static extern int GetPing(int entref);
 
+        [DllImport("iw5m.dll", EntryPoint = "GI_GetPlayerSnapshot")]
+        public static extern int GetPlayerSnapshot(int maxClients, [Out] int[] flags, [Out] float[] origins, [Out] float[] angles, [Out] int[] health, [Out] int[] teams, [Out] int[] pings);
+
+        [DllImport("iw5m.dll", EntryPoint = "GI_SpatialTrack")]
+        public static extern void SpatialTrack(int entref, int track);
+
+        [DllImport("iw5m.dll", EntryPoint = "GI_SpatialReset")]
+        public static extern void SpatialReset();
+
+        // the spatial queries rebuild the native grid when frame changed since the last query
+        [DllImport("iw5m.dll", EntryPoint = "GI_SpatialRadius")]
+        public static extern int SpatialRadius(int frame, int types, ref Vector3 center, float radius, [Out] int[] results, int maxResults);
+
+        [DllImport("iw5m.dll", EntryPoint = "GI_SpatialNearest")]
+        public static extern int SpatialNearest(int frame, int types, ref Vector3 center, float maxDistance, [Out] int[] results, int count);
+
+        [DllImport("iw5m.dll", EntryPoint = "GI_SpatialBox")]
+        public static extern int SpatialBox(int frame, int types, ref Vector3 mins, ref Vector3 maxs, [Out] int[] results, int maxResults);
+
         [DllImport("iw5m.dll", EntryPoint = "GI_GetClientAddress")]
         public static extern long GetClientAddress(int entref);
 
@@ -126,6 +177,12 @@ namespace InfinityScript
         [DllImport("iw5m.dll", EntryPoint = "GI_GetTempEntRef")]
         public static extern int Script_GetTempEntRef();
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern void Script_SubscribeNotify(string notify);
+
+        [DllImport("iw5m.dll", EntryPoint = "GI_SubscribeAllNotifies")]
+        public static extern void Script_SubscribeAllNotifies();
+
         // do not use
         [DllImport("iw5m.dll", EntryPoint = "GI_TempFunc")]
         public static extern void TempFunc();
@@ -9,27 +9,75 @@ namespace InfinityScript
         private static List<ILogListener> _listeners;
         private static LogLevel _filter;
 
+        // listeners that get messages regardless of the filter
+        private static int _numUnfilteredListeners;
+
+        // when on, messages without an explicit source get their caller as source, which walks the stack for each
+        // message; off by default, sv_scriptLogSource 1 turns it on
+        public static bool CaptureSource { get; set; }
+
         public static void Initialize(LogLevel filter)
         {
             _listeners = new List<ILogListener>();
+            _numUnfilteredListeners = 0;
             _filter = filter;
+
+            CaptureSource = false;
         }
 
         public static void AddListener(ILogListener listener)
         {
             _listeners.Add(listener);
+
+            if (!listener.WantsFilteredMessages)
+            {
+                _numUnfilteredListeners++;
+            }
         }
 
         public static void Write(LogLevel level, string message, params object[] args)
         {
-            Write(level, string.Format(message, args));
+            if (!IsWanted(level))
+            {
+                return;
+            }
+
+            Dispatch((CaptureSource) ? GetSource() : string.Empty, level, string.Format(message, args));
         }
 
         public static void Write(LogLevel level, string message)
         {
-            // get the source
-            var source = GetSource();
+            if (!IsWanted(level))
+            {
+                return;
+            }
 
+            Dispatch((CaptureSource) ? GetSource() : string.Empty, level, message);
+        }
+
+        // the source is given by the caller, so no stack walk is needed to find it
+        public static void Write(string source, LogLevel level, string message, params object[] args)
+        {
+            if (!IsWanted(level))
+            {
+                return;
+            }
+
+            Dispatch(source, level, string.Format(message, args));
+        }
+
+        public static void Write(string source, LogLevel level, string message)
+        {
+            if (!IsWanted(level))
+            {
+                return;
+            }
+
+            Dispatch(source, level, message);
+        }
+
+        private static void Dispatch(string source, LogLevel level, string message)
+        {
             // check filteredness
             var isAllowed = IsLevelAllowed(level);
 
@@ -43,6 +91,12 @@ namespace InfinityScript
             }
         }
 
+        // whether any listener gets the message, so that filtered messages aren't formatted at all
+        private static bool IsWanted(LogLevel level)
+        {
+            return (_numUnfilteredListeners > 0 || IsLevelAllowed(level));
+        }
+
         public static void Debug(string message)
         {
             Write(LogLevel.Debug, message);
@@ -50,7 +104,7 @@ namespace InfinityScript
 
         public static void Debug(string format, params object[] args)
         {
-            Debug(String.Format(format, args));
+            Write(LogLevel.Debug, format, args);
         }
 
         public static void Info(string message)
@@ -60,7 +114,7 @@ namespace InfinityScript
 
         public static void Info(string format, params object[] args)
         {
-            Info(String.Format(format, args));
+            Write(LogLevel.Info, format, args);
         }
 
         public static void Error(string message)
@@ -70,12 +124,12 @@ namespace InfinityScript
 
         public static void Error(Exception e)
         {
-            Error(e.ToString());
+            Write(LogLevel.Error, e.ToString());
         }
 
         public static void Error(string format, params object[] args)
         {
-            Error(String.Format(format, args));
+            Write(LogLevel.Error, format, args);
         }
 
         private static bool IsLevelAllowed(LogLevel level)
@@ -1,18 +1,64 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Globalization;
 using System.IO;
 using System.Linq;
 using System.Text;
+using System.Threading;
 
 namespace InfinityScript
 {
+    // writes the log from a background thread, so that the game thread only queues the messages
     public class FileLogListener : ILogListener
     {
+        private struct LogEntry
+        {
+            public DateTime time;
+            public string source;
+            public string message;
+            public LogLevel level;
+        }
+
+        private string _filename;
         private StreamWriter _writer;
+        private object _writeLock = new object();
+
+        private ConcurrentQueue<LogEntry> _queue = new ConcurrentQueue<LogEntry>();
+        private AutoResetEvent _wakeEvent = new AutoResetEvent(false);
+        private Thread _thread;
+        private int _numQueued;
+
+        // writes that failed since the last one that went through, reported in the file once it works again
+        private int _numFailures;
+        private string _firstFailure;
+
+        // queued messages that wake up the writer before the flush interval is over
+        private const int WakeThreshold = 1024;
+
+        // milliseconds between writes of the queued messages
+        public int FlushInterval { get; set; }
+
+        // the file is rotated once it grows past this size, 0 to never rotate
+        public long MaxFileSize { get; set; }
+
+        // number of rotated files kept, as filename.1 (newest) up to filename.N
+        public int MaxFiles { get; set; }
 
         public FileLogListener(string filename, bool append)
+            : this(filename, append, 1000, 0)
         {
+        }
+
+        public FileLogListener(string filename, bool append, int flushInterval, long maxFileSize)
+        {
+            _filename = filename;
+
+            FlushInterval = flushInterval;
+            MaxFileSize = maxFileSize;
+            MaxFiles = 5;
+
             try
             {
                 _writer = new StreamWriter(filename, append);
@@ -20,7 +66,17 @@ namespace InfinityScript
             catch (IOException)
             {
                 _writer = null;
+                return;
             }
+
+            _thread = new Thread(WriterThread);
+            _thread.IsBackground = true;
+            _thread.Name = "FileLogListener";
+            _thread.Start();
+
+            // the writer thread doesn't outlive the script domain, so write what's left when it goes away
+            AppDomain.CurrentDomain.DomainUnload += (sender, e) => Close();
+            AppDomain.CurrentDomain.ProcessExit += (sender, e) => Close();
         }
 
         public void LogMessage(string source, string message, LogLevel level)
@@ -30,15 +86,148 @@ namespace InfinityScript
                 return;
             }
 
-            var date = DateTime.Now.ToString("yyyy-MM-dd HH:mm:ss", CultureInfo.InvariantCulture);
-            var levelS = level.ToString().ToUpper();
-            var sourceS = (source == string.Empty) ? string.Empty : ("[" + source + "]");
+            _queue.Enqueue(new LogEntry()
+            {
+                time = DateTime.Now,
+                source = source,
+                message = message,
+                level = level
+            });
 
-            var text = string.Format("{0} - {1} - {2}: {3}", date, sourceS, levelS, message);
-            _writer.WriteLine(text);
-            _writer.Flush();
+            // critical messages usually come right before the server exits
+            if (level == LogLevel.Critical)
+            {
+                WriteQueued();
+            }
+            else if (Interlocked.Increment(ref _numQueued) == WakeThreshold)
+            {
+                _wakeEvent.Set();
+            }
         }
 
         public bool WantsFilteredMessages { get { return true; } }
+
+        private void WriterThread()
+        {
+            while (true)
+            {
+                _wakeEvent.WaitOne(Math.Max(FlushInterval, 1));
+
+                // an exception here would take the server down; the first failure goes to the debugger output right
+                // away, and the count to the file once it can be written again
+                try
+                {
+                    WriteQueued();
+                }
+                catch (Exception ex)
+                {
+                    if (Interlocked.Increment(ref _numFailures) == 1)
+                    {
+                        _firstFailure = ex.Message;
+                        Trace.WriteLine("[FileLogListener] Could not write to " + _filename + ": " + ex.ToString());
+                    }
+                }
+            }
+        }
+
+        private void WriteQueued()
+        {
+            // the game thread writes critical messages itself
+            lock (_writeLock)
+            {
+                if (_writer == null || _queue.IsEmpty)
+                {
+                    return;
+                }
+
+                Interlocked.Exchange(ref _numQueued, 0);
+
+                int numFailures = Interlocked.Exchange(ref _numFailures, 0);
+
+                if (numFailures > 0)
+                {
+                    _writer.WriteLine("{0} - [FileLogListener] - ERROR: {1} write(s) of this log failed, the first with: {2}",
+                        DateTime.Now.ToString("yyyy-MM-dd HH:mm:ss", CultureInfo.InvariantCulture), numFailures, _firstFailure);
+                }
+
+                LogEntry entry;
+
+                while (_queue.TryDequeue(out entry))
+                {
+                    var date = entry.time.ToString("yyyy-MM-dd HH:mm:ss", CultureInfo.InvariantCulture);
+                    var levelS = entry.level.ToString().ToUpper();
+                    var sourceS = (entry.source == string.Empty) ? string.Empty : ("[" + entry.source + "]");
+
+                    _writer.WriteLine("{0} - {1} - {2}: {3}", date, sourceS, levelS, entry.message);
+                }
+
+                _writer.Flush();
+
+                if (MaxFileSize > 0 && _writer.BaseStream.Length >= MaxFileSize)
+                {
+                    Rotate();
+                }
+            }
+        }
+
+        private void Close()
+        {
+            WriteQueued();
+
+            lock (_writeLock)
+            {
+                if (_writer != null)
+                {
+                    _writer.Close();
+                    _writer = null;
+                }
+            }
+        }
+
+        private void Rotate()
+        {
+            _writer.Close();
+
+            try
+            {
+                for (int i = MaxFiles - 1; i >= 1; i--)
+                {
+                    var from = _filename + "." + i;
+                    var to = _filename + "." + (i + 1);
+
+                    if (File.Exists(from))
+                    {
+                        File.Delete(to);
+                        File.Move(from, to);
+                    }
+                }
+
+                if (MaxFiles > 0)
+                {
+                    File.Delete(_filename + ".1");
+                    File.Move(_filename, _filename + ".1");
+                }
+            }
+            catch (IOException)
+            {
+                // keep writing to the same file instead
+            }
+            catch (UnauthorizedAccessException)
+            {
+            }
+
+            try
+            {
+                _writer = new StreamWriter(_filename, true);
+            }
+            catch (IOException)
+            {
+                _writer = null;
+            }
+            catch (UnauthorizedAccessException)
+            {
+                _writer = null;
+            }
+        }
     }
 }
@@ -9,7 +9,16 @@ namespace InfinityScript
     {
         public void LogMessage(string source, string message, LogLevel level)
         {
-            GameInterface.Print("[" + source + "] " + message + "\n");
+            var text = "[" + source + "] " + message + "\n";
+
+            // the game console can only be written from the game thread
+            if (ScriptWorker.IsWorkerThread)
+            {
+                ScriptWorker.RunOnMainThread(() => GameInterface.Print(text));
+                return;
+            }
+
+            GameInterface.Print(text);
         }
 
         public bool WantsFilteredMessages { get { return true; } }
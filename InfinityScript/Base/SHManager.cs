@@ -12,8 +12,10 @@ namespace InfinityScript
         public static void Initialize()
         {
             // initialize logging
+            var fileLog = new FileLogListener("InfinityScript.log", false, 1000, 10 * 1024 * 1024);
+
             Log.Initialize(LogLevel.All);
-            Log.AddListener(new FileLogListener("InfinityScript.log", false));
+            Log.AddListener(fileLog);
             Log.AddListener(new TraceLogListener());
             Log.AddListener(new GameLogListener());
 
@@ -22,30 +24,91 @@ namespace InfinityScript
             {
                 Entity.InitializeMappings();
                 ScriptNames.Initialize();
+                ConfigureLog(fileLog);
+                ScriptLoader.CleanShadowCopies();
+                ScriptReloader.Start();
+
+                // scripts can track entities from their constructors
+                SpatialIndex.Clear();
                 ScriptLoader.Initialize();
+
+                ScriptWatchdog.Start();
+                SubscribeCommands();
             }
             catch (Exception ex)
             {
-                Log.Write(LogLevel.Critical, ex.ToString());
-                Environment.Exit(0);
+                // a faulty script shouldn't take the server down with it; it keeps running without (some) scripts
+                Log.Write(LogLevel.Critical, "Failed to initialize scripts: {0}", ex.ToString());
             }
 
             //GameInterface.TempFunc();
             //Environment.Exit(0);
         }
 
+        // sv_scriptLogMaxSize (KB, 0 to never rotate), sv_scriptLogFlush (ms) and sv_scriptLogSource (0/1)
+        private static void ConfigureLog(FileLogListener fileLog)
+        {
+            try
+            {
+                fileLog.MaxFileSize = Function.Call<int>("getDvarInt", "sv_scriptLogMaxSize", 10240) * 1024L;
+                fileLog.FlushInterval = Function.Call<int>("getDvarInt", "sv_scriptLogFlush", 1000);
+                Log.CaptureSource = (Function.Call<int>("getDvarInt", "sv_scriptLogSource", 0) != 0);
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Warning, "Could not read the script log settings: {0}", ex.Message);
+            }
+        }
+
+        // used instead of a new script domain on a map change, when the script files didn't change
+        public static void Reset()
+        {
+            try
+            {
+                ScriptProcessor.Clear();
+                Entity.ClearEntities();
+                TimerScheduler.Clear();
+                CoroutineScheduler.Clear();
+                ScriptWorker.Clear();
+                HudElem.ClearAll();
+                ScriptWatchdog.Clear();
+                PlayerSnapshot.Invalidate();
+                SpatialIndex.Clear();
+                ScriptReloader.Clear();
+
+                SubscribeCommands();
+                ScriptReloader.Start();
+                ScriptLoader.LoadScripts();
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Critical, "Failed to reload scripts: {0}", ex.ToString());
+            }
+        }
+
         public static void RunFrame()
         {
             try
             {
+                FrameBudget.StartFrame();
+                PlayerSnapshot.Invalidate();
+                SpatialIndex.Invalidate();
+                ScriptReloader.RunFrame();
                 Entity.RunAll(entity => entity.ProcessNotifications());
-                Entity.RunAll(entity => entity.ProcessTimers());
-                ScriptProcessor.RunAll(script => script.RunFrame());
+                TimerScheduler.RunFrame();
+                CoroutineScheduler.RunFrame();
+                ScriptProcessor.RunAll("RunFrame", script => script.RunFrame());
+                ScriptWorker.RunFrame();
+                HudElem.FlushAll();
+                ScriptProfiler.RunFrame();
             }
             catch (Exception ex)
             {
-                Log.Write(LogLevel.Critical, ex.ToString());
-                Environment.Exit(0);
+                // script errors are handled per handler, this is the rest of the frame; keep the server running
+                if (!ScriptWatchdog.HandleAbort(ex))
+                {
+                    Log.Write(LogLevel.Error, "Exception during RunFrame: {0}", ex.ToString());
+                }
             }
             //GameInterface.Script_PushString("Hello!");
             //GameInterface.Script_PushInt(1337);
@@ -54,12 +117,13 @@ namespace InfinityScript
 
         public static void Shutdown()
         {
-            ScriptProcessor.RunAll(script => script.OnExitLevel());
+            ScriptProcessor.RunAll("OnExitLevel", script => script.OnExitLevel());
         }
 
         public static void LoadScript(string scriptName)
         {
             ScriptLoader.LoadAssemblies("scripts", scriptName);
+            ScriptManifest.Save();
         }
 
         public static bool HandleSay(int clientNum, string clientName, ref string message, int team)
@@ -68,7 +132,7 @@ namespace InfinityScript
             var eatgame = false;
             var eatscript = false;
             var messageTemp = message;
-            ScriptProcessor.RunAll(script =>
+            ScriptProcessor.RunAll("OnSay", script =>
             {
                 
                 // Run Script.OnSay3 (by reference, with team and eat)
@@ -105,13 +169,13 @@ namespace InfinityScript
             switch (funcID)
             {
                 case CallType.StartGameType:
-                    ScriptProcessor.RunAll(script => script.OnStartGameType());
+                    ScriptProcessor.RunAll("OnStartGameType", script => script.OnStartGameType());
                     break;
                 case CallType.PlayerConnect:
                     //ScriptProcessor.RunAll(script => script.OnPlayerConnect(entity));
                     break;
                 case CallType.PlayerDisconnect:
-                    ScriptProcessor.RunAll(script => script.OnPlayerDisconnect(entity));
+                    ScriptProcessor.RunAll("OnPlayerDisconnect", script => script.OnPlayerDisconnect(entity));
                     break;
                 case CallType.PlayerDamage:
                     if (paras[6].IsNull)
@@ -124,7 +188,7 @@ namespace InfinityScript
                         paras[7] = new Vector3(0, 0, 0);
                     }
 
-                    ScriptProcessor.RunAll(script => script.OnPlayerDamage(entity, paras[0].As<Entity>(), paras[1].As<Entity>(), paras[2].As<int>(), paras[3].As<int>(), paras[4].As<string>(), paras[5].As<string>(), paras[6].As<Vector3>(), paras[7].As<Vector3>(), paras[8].As<string>()));
+                    ScriptProcessor.RunAll("OnPlayerDamage", script => script.OnPlayerDamage(entity, paras[0].As<Entity>(), paras[1].As<Entity>(), paras[2].As<int>(), paras[3].As<int>(), paras[4].As<string>(), paras[5].As<string>(), paras[6].As<Vector3>(), paras[7].As<Vector3>(), paras[8].As<string>()));
                     break;
                 case CallType.PlayerKilled:
                     if (paras[5].IsNull)
@@ -132,7 +196,7 @@ namespace InfinityScript
                         paras[5] = new Vector3(0, 0, 0);
                     }
 
-                    ScriptProcessor.RunAll(script => script.OnPlayerKilled(entity, paras[0].As<Entity>(), paras[1].As<Entity>(), paras[2].As<int>(), paras[3].As<string>(), paras[4].As<string>(), paras[5].As<Vector3>(), paras[6].As<string>()));
+                    ScriptProcessor.RunAll("OnPlayerKilled", script => script.OnPlayerKilled(entity, paras[0].As<Entity>(), paras[1].As<Entity>(), paras[2].As<int>(), paras[3].As<string>(), paras[4].As<string>(), paras[5].As<Vector3>(), paras[6].As<string>()));
                     break;
             }
         }
@@ -162,21 +226,42 @@ namespace InfinityScript
                     entObj.HandleNotify(entity, type, paras);
                 }
 
-                ScriptProcessor.RunAll(script => script.HandleNotify(entity, type, paras));
+                ScriptProcessor.RunAll("HandleNotify", script => script.HandleNotify(entity, type, paras));
             }
         }
 
+        // the commands handled here rather than by scripts; scripts subscribe theirs when adding a handler
+        private static void SubscribeCommands()
+        {
+            GameInterface.Cmd_Subscribe("scriptprof");
+            GameInterface.Cmd_Subscribe("scriptbudget");
+            GameInterface.Cmd_Subscribe("scriptreload");
+        }
+
         public static bool HandleServerCommand(string commandName)
         {
-            var args = new string[GameInterface.Cmd_Argc()];
+            var args = GameInterface.Cmd_Args();
+
+            if (commandName.Equals("scriptprof", StringComparison.OrdinalIgnoreCase))
+            {
+                ScriptProfiler.HandleCommand(args);
+                return true;
+            }
+
+            if (commandName.Equals("scriptbudget", StringComparison.OrdinalIgnoreCase))
+            {
+                ScriptWatchdog.HandleCommand(args);
+                return true;
+            }
 
-            for (var i = 0; i < args.Length; i++)
+            if (commandName.Equals("scriptreload", StringComparison.OrdinalIgnoreCase))
             {
-                args[i] = GameInterface.Cmd_Argv(i);
+                ScriptReloader.HandleCommand(args);
+                return true;
             }
 
             var eat = false;
-            ScriptProcessor.RunAll(script =>
+            ScriptProcessor.RunAll("OnServerCommand", script =>
             {
                 var success = script.ProcessServerCommand(commandName.ToLowerInvariant(), args);
                 if (success)
@@ -189,17 +274,12 @@ namespace InfinityScript
 
         public static bool HandleClientCommand(string commandName, int entity)
         {
-            var args = new string[GameInterface.Cmd_Argc_sv()];
-
-            for (var i = 0; i < args.Length; i++)
-            {
-                args[i] = GameInterface.Cmd_Argv_sv(i);
-            }
+            var args = GameInterface.Cmd_Args_sv();
 
             var entObj = Entity.GetEntity(entity);
             var handled = false;
 
-            ScriptProcessor.RunAll(script =>
+            ScriptProcessor.RunAll("OnClientCommand", script =>
             {
                 var success = script.ProcessClientCommand(commandName.ToLowerInvariant(), entObj, args);
                 if (success)
@@ -211,39 +291,44 @@ namespace InfinityScript
             return handled;
         }
 
+        private static readonly Parameter[] _noParameters = new Parameter[0];
+
         private static Parameter[] CollectParameters(int numArgs)
         {
+            if (numArgs == 0)
+            {
+                return _noParameters;
+            }
+
             var paras = new Parameter[numArgs];
 
             for (int i = 0; i < numArgs; i++)
             {
                 var ptype = GameInterface.Script_GetType(i);
-                object value = null;
 
                 switch (ptype)
                 {
                     case VariableType.Integer:
-                        value = GameInterface.Script_GetInt(i);
+                        paras[i] = GameInterface.Script_GetInt(i);
                         break;
                     case VariableType.String:
-                        value = GameInterface.Script_GetString(i);
+                        paras[i] = GameInterface.Script_GetString(i);
                         break;
                     case VariableType.Float:
-                        value = GameInterface.Script_GetFloat(i);
+                        paras[i] = GameInterface.Script_GetFloat(i);
                         break;
                     case VariableType.Entity:
-                        value = Entity.GetEntity(GameInterface.Script_GetEntRef(i));
+                        paras[i] = Entity.GetEntity(GameInterface.Script_GetEntRef(i));
                         break;
                     case VariableType.Vector:
                         Vector3 v;
                         GameInterface.Script_GetVector(i, out v);
-                        value = v;
+                        paras[i] = v;
                         break;
                     default:
+                        paras[i] = new Parameter(ptype, null);
                         break;
                 }
-
-                paras[i] = new Parameter(ptype, value);
             }
 
             return paras;
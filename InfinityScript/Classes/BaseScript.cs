@@ -41,6 +41,22 @@ namespace InfinityScript
             });
         }
 
+        // for a script loaded while players are in the game already, as if they just joined
+        internal void AddConnectedPlayer(Entity player)
+        {
+            Players.Add(player);
+
+            if (PlayerConnecting != null)
+            {
+                PlayerConnecting(player);
+            }
+
+            if (PlayerConnected != null)
+            {
+                PlayerConnected(player);
+            }
+        }
+
         #region virtual call functions
         public virtual void OnStartGameType() { }
         public virtual void OnPlayerDisconnect(Entity player)
@@ -125,22 +141,35 @@ namespace InfinityScript
         #region timer adders
         public void OnInterval(int interval, Func<bool> function)
         {
-            _timers.Add(new ScriptTimer()
-            {
-                func = function,
-                triggerTime = 0,
-                interval = interval
-            });
+            AddTimer(0, interval, function);
         }
 
         public void AfterDelay(int delay, Action function)
         {
-            _timers.Add(new ScriptTimer()
-            {
-                func = function,
-                triggerTime = (_currentTime + delay),
-                interval = -1
-            });
+            AddTimer(delay, -1, function);
+        }
+
+        // same as OnInterval and AfterDelay, returning a handle that can cancel the timer
+        public ScriptTimer OnIntervalTimer(int interval, Func<bool> function)
+        {
+            return AddTimer(0, interval, function);
+        }
+
+        public ScriptTimer AfterDelayTimer(int delay, Action function)
+        {
+            return AddTimer(delay, -1, function);
+        }
+        #endregion
+
+        #region coroutine waits
+        public static WaitRequest Wait(int milliseconds)
+        {
+            return new WaitRequest(WaitType.Time, milliseconds, null, null, null);
+        }
+
+        public static WaitRequest NextFrame()
+        {
+            return new WaitRequest(WaitType.NextFrame, 0, null, null, null);
         }
         #endregion
 
@@ -150,6 +179,8 @@ namespace InfinityScript
             // handle tick
             if (Tick != null)
             {
+                var sample = ScriptProfiler.Begin();
+
                 try
                 {
                     Tick();
@@ -158,9 +189,10 @@ namespace InfinityScript
                 {
                     Log.Write(LogLevel.Error, "Exception during Tick on script {0}: {1}", GetType().Name, ex.ToString());
                 }
+
+                ScriptProfiler.End(GetType(), "Tick", sample);
             }
 
-            ProcessTimers();
             ProcessNotifications();
         }
         #endregion
@@ -169,9 +201,9 @@ namespace InfinityScript
         public void Notify(string type, params Parameter[] parameters)
         {
             // push arguments
-            foreach (var parameter in parameters.Reverse())
+            for (int i = parameters.Length - 1; i >= 0; i--)
             {
-                parameter.PushValue();
+                parameters[i].PushValue();
             }
 
             // call game function
@@ -203,6 +235,67 @@ namespace InfinityScript
             Function.SetEntRef(-1);
             return Function.Call<TReturn>(identifier, parameters);
         }
+
+        public void Call(ScriptFunction func, params Parameter[] parameters)
+        {
+            Function.SetEntRef(-1);
+            Function.Call(func, parameters);
+        }
+
+        public TReturn Call<TReturn>(ScriptFunction func, params Parameter[] parameters)
+        {
+            Function.SetEntRef(-1);
+            return Function.Call<TReturn>(func, parameters);
+        }
+
+        // fixed argument counts, these don't allocate a params array
+        public void Call(string func)
+        {
+            Function.SetEntRef(-1);
+            Function.Call(func);
+        }
+
+        public void Call(string func, Parameter arg1)
+        {
+            Function.SetEntRef(-1);
+            Function.Call(func, arg1);
+        }
+
+        public void Call(string func, Parameter arg1, Parameter arg2)
+        {
+            Function.SetEntRef(-1);
+            Function.Call(func, arg1, arg2);
+        }
+
+        public void Call(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            Function.SetEntRef(-1);
+            Function.Call(func, arg1, arg2, arg3);
+        }
+
+        public TReturn Call<TReturn>(string func)
+        {
+            Function.SetEntRef(-1);
+            return Function.Call<TReturn>(func);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1)
+        {
+            Function.SetEntRef(-1);
+            return Function.Call<TReturn>(func, arg1);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2)
+        {
+            Function.SetEntRef(-1);
+            return Function.Call<TReturn>(func, arg1, arg2);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            Function.SetEntRef(-1);
+            return Function.Call<TReturn>(func, arg1, arg2, arg3);
+        }
         #endregion
 
         #region commands
@@ -245,6 +338,9 @@ namespace InfinityScript
             if (!_serverCommandHandlers.ContainsKey(command))
             {
                 _serverCommandHandlers[command] = new List<Func<string[], bool>>();
+
+                // the game only passes the commands we subscribed to
+                GameInterface.Cmd_Subscribe(command);
             }
             _serverCommandHandlers[command].Add(func);
         }
@@ -270,6 +366,8 @@ namespace InfinityScript
             if (!_clientCommandHandlers.ContainsKey(command))
             {
                 _clientCommandHandlers[command] = new List<Action<Entity, string[]>>();
+
+                GameInterface.Cmd_Subscribe_sv(command);
             }
             _clientCommandHandlers[command].Add(func);
         }
@@ -10,89 +10,90 @@ namespace InfinityScript
     public class Entity : Notifiable
     {
         #region static field stuff
-        private static Dictionary<string, int> _fieldNames = new Dictionary<string, int>();
-
-        private static void AddFieldMapping(string name, int id)
-        {
-            _fieldNames[name.ToLowerInvariant()] = id;
-        }
+        private static NameTable _fieldNames;
 
         internal static void InitializeMappings()
         {
-            AddFieldMapping("code_classname", 0);
-            AddFieldMapping("classname", 1);
-            AddFieldMapping("origin", 2);
-            AddFieldMapping("model", 3);
-            AddFieldMapping("spawnflags", 4);
-            AddFieldMapping("target", 5);
-            AddFieldMapping("targetname", 6);
-            AddFieldMapping("count", 7);
-            AddFieldMapping("health", 8);
-            AddFieldMapping("dmg", 9);
-            AddFieldMapping("angles", 10);
-            AddFieldMapping("birthtime", 11);
-            AddFieldMapping("script_linkname", 12);
-            AddFieldMapping("slidevelocity", 13);
-            AddFieldMapping("name", 24576);
-            AddFieldMapping("sessionteam", 24577);
-            AddFieldMapping("sessionstate", 24578);
-            AddFieldMapping("maxhealth", 24579);
-            AddFieldMapping("score", 24580);
-            AddFieldMapping("deaths", 24581);
-            AddFieldMapping("statusicon", 24582);
-            AddFieldMapping("headicon", 24583);
-            AddFieldMapping("headiconteam", 24584);
-            AddFieldMapping("kills", 24585);
-            AddFieldMapping("assists", 24586);
-            AddFieldMapping("hasradar", 24587);
-            AddFieldMapping("isradarblocked", 24588);
-            AddFieldMapping("radarstrength", 24589);
-            AddFieldMapping("radarshowenemydirection", 24590);
-            AddFieldMapping("radarmode", 24591);
-            AddFieldMapping("forcespectatorclient", 24592);
-            AddFieldMapping("killcamentity", 24593);
-            AddFieldMapping("killcamentitylookat", 24594);
-            AddFieldMapping("archivetime", 24595);
-            AddFieldMapping("psoffsettime", 24596);
-            AddFieldMapping("pers", 24597);
-            AddFieldMapping("veh_speed", 32768);
-            AddFieldMapping("veh_pathspeed", 32769);
-            AddFieldMapping("veh_transmission", 32770);
-            AddFieldMapping("veh_pathdir", 32771);
-            AddFieldMapping("veh_pathtype", 32772);
-            AddFieldMapping("veh_topspeed", 32773);
-            AddFieldMapping("veh_brake", 32774);
-            AddFieldMapping("veh_throttle", 32775);
-            AddFieldMapping("x", 0);
-            AddFieldMapping("y", 1);
-            AddFieldMapping("z", 2);
-            AddFieldMapping("fontscale", 3);
-            AddFieldMapping("font", 4);
-            AddFieldMapping("alignx", 5);
-            AddFieldMapping("aligny", 6);
-            AddFieldMapping("horzalign", 7);
-            AddFieldMapping("vertalign", 8);
-            AddFieldMapping("color", 9);
-            AddFieldMapping("alpha", 10);
-            AddFieldMapping("label", 11);
-            AddFieldMapping("sort", 12);
-            AddFieldMapping("foreground", 13);
-            AddFieldMapping("lowresbackground", 14);
-            AddFieldMapping("hidewhendead", 15);
-            AddFieldMapping("hidewheninmenu", 16);
-            AddFieldMapping("glowcolor", 17);
-            AddFieldMapping("glowalpha", 18);
-            AddFieldMapping("archived", 19);
-            AddFieldMapping("hidein3rdperson", 20);
-            //AddFieldMapping("targetname", 0);
-            //AddFieldMapping("target", 1);
-            AddFieldMapping("script_linkname", 2);
-            AddFieldMapping("script_noteworthy", 3);
-            //AddFieldMapping("origin", 4);
-            //AddFieldMapping("angles", 5);
-            AddFieldMapping("speed", 6);
-            AddFieldMapping("lookahead", 7);
-        }
+            _fieldNames = new NameTable(_fieldMappings);
+        }
+
+        // later entries override earlier ones with the same name
+        private static readonly NameEntry[] _fieldMappings = new NameEntry[]
+        {
+            new NameEntry("code_classname", 0),
+            new NameEntry("classname", 1),
+            new NameEntry("origin", 2),
+            new NameEntry("model", 3),
+            new NameEntry("spawnflags", 4),
+            new NameEntry("target", 5),
+            new NameEntry("targetname", 6),
+            new NameEntry("count", 7),
+            new NameEntry("health", 8),
+            new NameEntry("dmg", 9),
+            new NameEntry("angles", 10),
+            new NameEntry("birthtime", 11),
+            new NameEntry("script_linkname", 12),
+            new NameEntry("slidevelocity", 13),
+            new NameEntry("name", 24576),
+            new NameEntry("sessionteam", 24577),
+            new NameEntry("sessionstate", 24578),
+            new NameEntry("maxhealth", 24579),
+            new NameEntry("score", 24580),
+            new NameEntry("deaths", 24581),
+            new NameEntry("statusicon", 24582),
+            new NameEntry("headicon", 24583),
+            new NameEntry("headiconteam", 24584),
+            new NameEntry("kills", 24585),
+            new NameEntry("assists", 24586),
+            new NameEntry("hasradar", 24587),
+            new NameEntry("isradarblocked", 24588),
+            new NameEntry("radarstrength", 24589),
+            new NameEntry("radarshowenemydirection", 24590),
+            new NameEntry("radarmode", 24591),
+            new NameEntry("forcespectatorclient", 24592),
+            new NameEntry("killcamentity", 24593),
+            new NameEntry("killcamentitylookat", 24594),
+            new NameEntry("archivetime", 24595),
+            new NameEntry("psoffsettime", 24596),
+            new NameEntry("pers", 24597),
+            new NameEntry("veh_speed", 32768),
+            new NameEntry("veh_pathspeed", 32769),
+            new NameEntry("veh_transmission", 32770),
+            new NameEntry("veh_pathdir", 32771),
+            new NameEntry("veh_pathtype", 32772),
+            new NameEntry("veh_topspeed", 32773),
+            new NameEntry("veh_brake", 32774),
+            new NameEntry("veh_throttle", 32775),
+            new NameEntry("x", 0),
+            new NameEntry("y", 1),
+            new NameEntry("z", 2),
+            new NameEntry("fontscale", 3),
+            new NameEntry("font", 4),
+            new NameEntry("alignx", 5),
+            new NameEntry("aligny", 6),
+            new NameEntry("horzalign", 7),
+            new NameEntry("vertalign", 8),
+            new NameEntry("color", 9),
+            new NameEntry("alpha", 10),
+            new NameEntry("label", 11),
+            new NameEntry("sort", 12),
+            new NameEntry("foreground", 13),
+            new NameEntry("lowresbackground", 14),
+            new NameEntry("hidewhendead", 15),
+            new NameEntry("hidewheninmenu", 16),
+            new NameEntry("glowcolor", 17),
+            new NameEntry("glowalpha", 18),
+            new NameEntry("archived", 19),
+            new NameEntry("hidein3rdperson", 20),
+            //new NameEntry("targetname", 0),
+            //new NameEntry("target", 1),
+            new NameEntry("script_linkname", 2),
+            new NameEntry("script_noteworthy", 3),
+            //new NameEntry("origin", 4),
+            //new NameEntry("angles", 5),
+            new NameEntry("speed", 6),
+            new NameEntry("lookahead", 7)
+        };
         #endregion
 
         private int _entRef;
@@ -100,14 +101,6 @@ namespace InfinityScript
         internal Entity(int entRef)
         {
             _entRef = entRef;
-
-            OnNotify("spawned_player", thisEntity =>
-            {
-                if (thisEntity.SpawnedPlayer != null)
-                {
-                    thisEntity.SpawnedPlayer();
-                }
-            });
         }
 
         public int EntRef
@@ -176,7 +169,34 @@ namespace InfinityScript
         #endregion
 
         #region events
-        public event Action SpawnedPlayer;
+        private EventSubscribers _spawnedPlayer;
+
+        public event Action SpawnedPlayer
+        {
+            add
+            {
+                if (_spawnedPlayer == null)
+                {
+                    _spawnedPlayer = new EventSubscribers("SpawnedPlayer");
+
+                    GameInterface.Script_SubscribeNotify("spawned_player");
+                }
+
+                _spawnedPlayer.Add(value);
+            }
+            remove
+            {
+                if (_spawnedPlayer != null)
+                {
+                    _spawnedPlayer.Remove(value);
+                }
+            }
+        }
+
+        internal override EventSubscribers GetEventSubscribers(string type)
+        {
+            return (type == "spawned_player") ? _spawnedPlayer : null;
+        }
         #endregion
 
         #region predefined calls
@@ -255,6 +275,67 @@ namespace InfinityScript
             Function.SetEntRef(_entRef);
             return Function.Call<TReturn>(identifier, parameters);
         }
+
+        public void Call(ScriptFunction func, params Parameter[] parameters)
+        {
+            Function.SetEntRef(_entRef);
+            Function.Call(func, parameters);
+        }
+
+        public TReturn Call<TReturn>(ScriptFunction func, params Parameter[] parameters)
+        {
+            Function.SetEntRef(_entRef);
+            return Function.Call<TReturn>(func, parameters);
+        }
+
+        // fixed argument counts, these don't allocate a params array
+        public void Call(string func)
+        {
+            Function.SetEntRef(_entRef);
+            Function.Call(func);
+        }
+
+        public void Call(string func, Parameter arg1)
+        {
+            Function.SetEntRef(_entRef);
+            Function.Call(func, arg1);
+        }
+
+        public void Call(string func, Parameter arg1, Parameter arg2)
+        {
+            Function.SetEntRef(_entRef);
+            Function.Call(func, arg1, arg2);
+        }
+
+        public void Call(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            Function.SetEntRef(_entRef);
+            Function.Call(func, arg1, arg2, arg3);
+        }
+
+        public TReturn Call<TReturn>(string func)
+        {
+            Function.SetEntRef(_entRef);
+            return Function.Call<TReturn>(func);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1)
+        {
+            Function.SetEntRef(_entRef);
+            return Function.Call<TReturn>(func, arg1);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2)
+        {
+            Function.SetEntRef(_entRef);
+            return Function.Call<TReturn>(func, arg1, arg2);
+        }
+
+        public TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            Function.SetEntRef(_entRef);
+            return Function.Call<TReturn>(func, arg1, arg2, arg3);
+        }
         #endregion
 
         #region call wrappers
@@ -333,26 +414,53 @@ namespace InfinityScript
         #endregion
 
         #region fields
-        private Dictionary<string, object> _privateFields = new Dictionary<string, object>();
+        private Dictionary<string, object> _privateFields = new Dictionary<string, object>(StringComparer.OrdinalIgnoreCase);
 
-        public bool HasField(string name)
+        internal static ScriptField ResolveField(string name)
         {
-            name = name.ToLowerInvariant();
+            int fieldID;
+
+            if (!_fieldNames.TryGetValue(name, out fieldID))
+            {
+                fieldID = -1;
+            }
+
+            return new ScriptField(name.ToLowerInvariant(), fieldID);
+        }
 
+        public bool HasField(string name)
+        {
             return (_fieldNames.ContainsKey(name) || _privateFields.ContainsKey(name));
         }
 
         public T GetField<T>(string name)
         {
-            name = name.ToLowerInvariant();
+            int fieldID;
 
-            if (!_fieldNames.ContainsKey(name))
+            if (!_fieldNames.TryGetValue(name, out fieldID))
             {
                 return (T)_privateFields[name];
             }
 
-            object returnValue = null;
-            int fieldID = _fieldNames[name];
+            return GetGameField<T>(fieldID);
+        }
+
+        public T GetField<T>(ScriptField field)
+        {
+            if (!field.IsGameField)
+            {
+                return (T)_privateFields[field.Name];
+            }
+
+            return GetGameField<T>(field.Identifier);
+        }
+
+        private T GetGameField<T>(int fieldID)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
+            Parameter returnValue = default(Parameter);
 
             GameInterface.Script_GetField(_entRef, fieldID);
 
@@ -376,33 +484,52 @@ namespace InfinityScript
 
             GameInterface.Script_CleanReturnStack();
 
-            return (T)Convert.ChangeType(returnValue, typeof(T));
+            return returnValue.As<T>();
         }
 
         public void SetField(string name, Parameter value)
         {
-            name = name.ToLowerInvariant();
+            int fieldID;
 
-            if (!_fieldNames.ContainsKey(name))
+            if (!_fieldNames.TryGetValue(name, out fieldID))
             {
                 _privateFields[name] = value.InternalValue;
                 return;
             }
 
-            int fieldID = _fieldNames[name];
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
 
             value.PushValue();
             GameInterface.Script_SetField(_entRef, fieldID);
         }
+
+        public void SetField(ScriptField field, Parameter value)
+        {
+            if (!field.IsGameField)
+            {
+                _privateFields[field.Name] = value.InternalValue;
+                return;
+            }
+
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
+            value.PushValue();
+            GameInterface.Script_SetField(_entRef, field.Identifier);
+        }
         #endregion
 
         #region notify
         public void Notify(string type, params Parameter[] parameters)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             // push arguments
-            foreach (var parameter in parameters.Reverse())
+            for (int i = parameters.Length - 1; i >= 0; i--)
             {
-                parameter.PushValue();
+                parameters[i].PushValue();
             }
 
             // call game function
@@ -411,34 +538,191 @@ namespace InfinityScript
         #endregion
 
         #region pool stuff
-        private static Dictionary<int, Entity> _entities = new Dictionary<int, Entity>();
+        private struct EntitySlot
+        {
+            public Entity entity;
+
+            // bumped whenever the slot's entity goes away, so references kept to it can tell
+            public int generation;
+        }
+
+        // indexed by entity class (the upper half of the entref), then entity number
+        private static EntitySlot[][] _slots = new EntitySlot[4][];
+
+        // all known entities, packed; removal leaves a null that RunAll compacts away
+        private static Entity[] _active = new Entity[256];
+        private static int _numActive;
+        private static bool _hasHoles;
+
+        private int _generation;
+        private int _activeIndex = -1;
+
+        // false once the entity got removed, like a player that disconnected
+        public bool IsValid
+        {
+            get
+            {
+                var slots = GetSlots(_entRef, false);
+
+                return slots != null && slots[_entRef & 0xFFFF].generation == _generation && slots[_entRef & 0xFFFF].entity == this;
+            }
+        }
+
+        private static EntitySlot[] GetSlots(int entRef, bool create)
+        {
+            int entClass = entRef >> 16;
+            int entNum = entRef & 0xFFFF;
+
+            if (entClass < 0)
+            {
+                return null;
+            }
+
+            if (entClass >= _slots.Length)
+            {
+                if (!create)
+                {
+                    return null;
+                }
+
+                Array.Resize(ref _slots, entClass + 1);
+            }
+
+            var slots = _slots[entClass];
+
+            if (slots == null || entNum >= slots.Length)
+            {
+                if (!create)
+                {
+                    return null;
+                }
+
+                // entity numbers are small (2048 game entities, 1024 hud elements), so grow to fit
+                Array.Resize(ref slots, Math.Max(entNum + 1, (slots == null) ? 64 : slots.Length * 2));
+                _slots[entClass] = slots;
+            }
+
+            return slots;
+        }
 
         public static Entity GetEntity(int entRef)
         {
-            if (_entities.ContainsKey(entRef))
+            var slots = GetSlots(entRef, true);
+
+            // not a valid entref, so nothing to keep track of
+            if (slots == null)
+            {
+                return new Entity(entRef);
+            }
+
+            var entNum = entRef & 0xFFFF;
+            var entity = slots[entNum].entity;
+
+            if (entity != null)
+            {
+                return entity;
+            }
+
+            entity = new Entity(entRef);
+            entity._generation = slots[entNum].generation;
+            slots[entNum].entity = entity;
+
+            if (_numActive == _active.Length)
             {
-                return _entities[entRef];
+                Array.Resize(ref _active, _active.Length * 2);
             }
 
-            var entity = new Entity(entRef);
-            _entities[entRef] = entity;
+            entity._activeIndex = _numActive;
+            _active[_numActive++] = entity;
+
             if (entRef < 18)
             {
                 entity.OnNotify("disconnect", ent =>
                 {
-                    _entities.Remove(ent.EntRef);
+                    RemoveEntity(ent);
+                    ent._timersStopped = true;
                 });
             }
 
             return entity;
         }
 
+        internal static void RemoveEntity(int entRef)
+        {
+            var slots = GetSlots(entRef, false);
+
+            if (slots != null && slots[entRef & 0xFFFF].entity != null)
+            {
+                RemoveEntity(slots[entRef & 0xFFFF].entity);
+            }
+        }
+
+        private static void RemoveEntity(Entity entity)
+        {
+            var slots = GetSlots(entity._entRef, false);
+            var entNum = entity._entRef & 0xFFFF;
+
+            if (slots == null || slots[entNum].entity != entity)
+            {
+                return;
+            }
+
+            slots[entNum].entity = null;
+            slots[entNum].generation++;
+
+            _active[entity._activeIndex] = null;
+            entity._activeIndex = -1;
+            _hasHoles = true;
+        }
+
+        internal static void ClearEntities()
+        {
+            for (int i = 0; i < _numActive; i++)
+            {
+                var entity = _active[i];
+
+                if (entity != null)
+                {
+                    entity._timersStopped = true;
+                    entity._activeIndex = -1;
+                    entity.CancelWaiters();
+                }
+
+                _active[i] = null;
+            }
+
+            foreach (var slots in _slots)
+            {
+                if (slots == null)
+                {
+                    continue;
+                }
+
+                for (int i = 0; i < slots.Length; i++)
+                {
+                    slots[i].entity = null;
+                    slots[i].generation++;
+                }
+            }
+
+            _numActive = 0;
+            _hasHoles = false;
+        }
+
         internal static void RunAll(Action<Entity> cb)
         {
-            var entities = _entities.Values.ToArray();
+            // entities added by the callbacks wait for the next frame, like they did with a copied list
+            int count = _numActive;
 
-            foreach (var entity in entities)
+            for (int i = 0; i < count; i++)
             {
+                var entity = _active[i];
+
+                if (entity == null)
+                {
+                    continue;
+                }
+
                 try
                 {
                     cb(entity);
@@ -448,28 +732,55 @@ namespace InfinityScript
                     Log.Write(LogLevel.Error, "Exception during RunAll call: {0}", ex.ToString());
                 }
             }
+
+            if (_hasHoles)
+            {
+                CompactActive();
+            }
+        }
+
+        private static void CompactActive()
+        {
+            int count = 0;
+
+            for (int i = 0; i < _numActive; i++)
+            {
+                var entity = _active[i];
+
+                if (entity != null)
+                {
+                    entity._activeIndex = count;
+                    _active[count++] = entity;
+                }
+            }
+
+            Array.Clear(_active, count, _numActive - count);
+
+            _numActive = count;
+            _hasHoles = false;
         }
         #endregion
 
         #region ontimer
         public void OnInterval(int interval, Func<Entity, bool> function)
         {
-            _timers.Add(new ScriptTimer()
-            {
-                func = function,
-                triggerTime = 0,
-                interval = interval
-            });
+            AddTimer(0, interval, function);
         }
 
         public void AfterDelay(int delay, Action<Entity> function)
         {
-            _timers.Add(new ScriptTimer()
-            {
-                func = function,
-                triggerTime = (_currentTime + delay),
-                interval = -1
-            });
+            AddTimer(delay, -1, function);
+        }
+
+        // same as OnInterval and AfterDelay, returning a handle that can cancel the timer
+        public ScriptTimer OnIntervalTimer(int interval, Func<Entity, bool> function)
+        {
+            return AddTimer(0, interval, function);
+        }
+
+        public ScriptTimer AfterDelayTimer(int delay, Action<Entity> function)
+        {
+            return AddTimer(delay, -1, function);
         }
         #endregion
 
@@ -38,11 +38,35 @@ namespace InfinityScript
         {
             Entity = entity;
             Children = new List<HudElem>();
+
+            // a new element may have the entref of a destroyed one, whose shadow no longer matches the game
+            if (entity != null)
+            {
+                HudElem previous;
+
+                if (_hudElems.TryGetValue(entity.EntRef, out previous) && previous != this)
+                {
+                    previous._known = 0;
+                    previous._dirty = 0;
+                }
+
+                _hudElems[entity.EntRef] = this;
+            }
         }
 
         public static HudElem GetHudElem(int entRef)
         {
-            return new HudElem(new Entity(entRef));
+            ScriptWorker.AssertMainThread();
+
+            HudElem elem;
+
+            // the known one shares its field shadow, unless its slot got freed since
+            if (_hudElems.TryGetValue(entRef, out elem) && elem.Entity.IsValid)
+            {
+                return elem;
+            }
+
+            return new HudElem(Entity.GetEntity(entRef));
         }
 
         public float X
@@ -54,11 +78,11 @@ namespace InfinityScript
                     return 0;
                 }
 
-                return Entity.GetField<float>("x");
+                return GetFloat(HudField.X);
             }
             set
             {
-                Entity.SetField("x", value);
+                SetFloat(HudField.X, value);
             }
         }
 
@@ -71,11 +95,11 @@ namespace InfinityScript
                     return 0;
                 }
 
-                return Entity.GetField<float>("y");
+                return GetFloat(HudField.Y);
             }
             set
             {
-                Entity.SetField("y", value);
+                SetFloat(HudField.Y, value);
             }
         }
 
@@ -83,11 +107,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<float>("z");
+                return GetFloat(HudField.Z);
             }
             set
             {
-                Entity.SetField("z", value);
+                SetFloat(HudField.Z, value);
             }
         }
 
@@ -95,11 +119,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<float>("fontscale");
+                return GetFloat(HudField.FontScale);
             }
             set
             {
-                Entity.SetField("fontscale", value);
+                SetFloat(HudField.FontScale, value);
             }
         }
 
@@ -107,11 +131,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<string>("font");
+                return GetString(HudField.Font);
             }
             set
             {
-                Entity.SetField("font", value);
+                SetString(HudField.Font, value);
             }
         }
 
@@ -124,11 +148,11 @@ namespace InfinityScript
                     return "left";
                 }
 
-                return Entity.GetField<string>("alignx");
+                return GetString(HudField.AlignX);
             }
             set
             {
-                Entity.SetField("alignx", value);
+                SetString(HudField.AlignX, value);
             }
         }
 
@@ -141,11 +165,11 @@ namespace InfinityScript
                     return "top";
                 }
 
-                return Entity.GetField<string>("aligny");
+                return GetString(HudField.AlignY);
             }
             set
             {
-                Entity.SetField("aligny", value);
+                SetString(HudField.AlignY, value);
             }
         }
 
@@ -158,11 +182,11 @@ namespace InfinityScript
                     return "left";
                 }
 
-                return Entity.GetField<string>("horzalign");
+                return GetString(HudField.HorzAlign);
             }
             set
             {
-                Entity.SetField("horzalign", value);
+                SetString(HudField.HorzAlign, value);
             }
         }
 
@@ -175,11 +199,11 @@ namespace InfinityScript
                     return "top";
                 }
 
-                return Entity.GetField<string>("vertalign");
+                return GetString(HudField.VertAlign);
             }
             set
             {
-                Entity.SetField("vertalign", value);
+                SetString(HudField.VertAlign, value);
             }
         }
 
@@ -187,11 +211,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<float>("alpha");
+                return GetFloat(HudField.Alpha);
             }
             set
             {
-                Entity.SetField("alpha", value);
+                SetFloat(HudField.Alpha, value);
             }
         }
 
@@ -199,11 +223,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<float>("glowalpha");
+                return GetFloat(HudField.GlowAlpha);
             }
             set
             {
-                Entity.SetField("glowalpha", value);
+                SetFloat(HudField.GlowAlpha, value);
             }
         }
 
@@ -211,11 +235,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<int>("sort");
+                return GetInt(HudField.Sort);
             }
             set
             {
-                Entity.SetField("sort", value);
+                SetInt(HudField.Sort, value);
             }
         }
 
@@ -223,11 +247,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<int>("hidewheninmenu") != 0;
+                return GetBool(HudField.HideWhenInMenu);
             }
             set
             {
-                Entity.SetField("hidewheninmenu", value);
+                SetBool(HudField.HideWhenInMenu, value);
             }
         }
 
@@ -235,11 +259,11 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<int>("archived") != 0;
+                return GetBool(HudField.Archived);
             }
             set
             {
-                Entity.SetField("archived", value);
+                SetBool(HudField.Archived, value);
             }
         }
 
@@ -247,22 +271,24 @@ namespace InfinityScript
         {
             get
             {
-                return Entity.GetField<int>("foreground") != 0;
+                return GetBool(HudField.Foreground);
             }
             set
             {
-                Entity.SetField("foreground", value);
+                SetBool(HudField.Foreground, value);
             }
         }
 
         public void SetText(string text)
         {
             //Entity.Call("clearalltextafterhudelem"); // frees configstrings - might cause all configstrings to resync, needs testing in a real-world scenario
+            BeforeCall(null);
             Entity.Call("settext", text);
         }
 
         public void SetShader(string shader, int w, int h)
         {
+            BeforeCall(null);
             Entity.Call("setshader", shader, w, h);
         }
 
@@ -270,11 +296,11 @@ namespace InfinityScript
         {
             get
             {
-                return GetField<Vector3>("color");
+                return GetVector(HudField.Color);
             }
             set
             {
-                SetField("color", value);
+                SetVector(HudField.Color, value);
             }
         }
 
@@ -282,35 +308,353 @@ namespace InfinityScript
         {
             get
             {
-                return GetField<Vector3>("glowcolor");
+                return GetVector(HudField.GlowColor);
             }
             set
             {
-                SetField("glowcolor", value);
+                SetVector(HudField.GlowColor, value);
             }
         }
 
+        #region field shadow
+        // game fields mirrored in managed memory; changes are sent to the game once per frame, and only if the value changed
+        private enum HudField
+        {
+            X,
+            Y,
+            Z,
+            FontScale,
+            Alpha,
+            GlowAlpha,
+            Sort,
+            HideWhenInMenu,
+            Archived,
+            Foreground,
+            Font,
+            AlignX,
+            AlignY,
+            HorzAlign,
+            VertAlign,
+            Color,
+            GlowColor,
+            Count
+        }
+
+        private struct FieldValue
+        {
+            public Vector3 vector; // floats use X
+            public int integer;
+            public string text;
+        }
+
+        private static readonly string[] _fieldNames = new[] { "x", "y", "z", "fontscale", "alpha", "glowalpha", "sort", "hidewheninmenu", "archived", "foreground", "font", "alignx", "aligny", "horzalign", "vertalign", "color", "glowcolor" };
+
+        private static readonly VariableType[] _fieldTypes = new[]
+        {
+            VariableType.Float, VariableType.Float, VariableType.Float, VariableType.Float, VariableType.Float, VariableType.Float,
+            VariableType.Integer, VariableType.Integer, VariableType.Integer, VariableType.Integer,
+            VariableType.String, VariableType.String, VariableType.String, VariableType.String, VariableType.String,
+            VariableType.Vector, VariableType.Vector
+        };
+
+        private static int[] _fieldIDs;
+
+        private static Dictionary<int, HudElem> _hudElems = new Dictionary<int, HudElem>();
+        private static List<HudElem> _dirtyElems = new List<HudElem>();
+
+        private static FieldUpdate[] _updates = new FieldUpdate[64];
+        private static string[] _updateStrings = new string[16];
+
+        private FieldValue[] _values;
+
+        // fields with a value in _values that matches the game, or will after the next flush
+        private int _known;
+        private int _dirty;
+
+        private float GetFloat(HudField field)
+        {
+            return ReadField(field).vector.X;
+        }
+
+        private int GetInt(HudField field)
+        {
+            return ReadField(field).integer;
+        }
+
+        private bool GetBool(HudField field)
+        {
+            return ReadField(field).integer != 0;
+        }
+
+        private string GetString(HudField field)
+        {
+            return ReadField(field).text;
+        }
+
+        private Vector3 GetVector(HudField field)
+        {
+            return ReadField(field).vector;
+        }
+
+        private void SetFloat(HudField field, float value)
+        {
+            ScriptWorker.AssertMainThread();
+
+            if (!IsKnown(field) || _values[(int)field].vector.X != value)
+            {
+                _values[(int)field].vector.X = value;
+                MarkDirty(field);
+            }
+        }
+
+        private void SetInt(HudField field, int value)
+        {
+            ScriptWorker.AssertMainThread();
+
+            if (!IsKnown(field) || _values[(int)field].integer != value)
+            {
+                _values[(int)field].integer = value;
+                MarkDirty(field);
+            }
+        }
+
+        private void SetBool(HudField field, bool value)
+        {
+            SetInt(field, value ? 1 : 0);
+        }
+
+        private void SetString(HudField field, string value)
+        {
+            ScriptWorker.AssertMainThread();
+
+            if (!IsKnown(field) || _values[(int)field].text != value)
+            {
+                _values[(int)field].text = value;
+                MarkDirty(field);
+            }
+        }
+
+        private void SetVector(HudField field, Vector3 value)
+        {
+            ScriptWorker.AssertMainThread();
+
+            var current = _values[(int)field].vector;
+
+            if (!IsKnown(field) || current.X != value.X || current.Y != value.Y || current.Z != value.Z)
+            {
+                _values[(int)field].vector = value;
+                MarkDirty(field);
+            }
+        }
+
+        private bool IsKnown(HudField field)
+        {
+            if (_values == null)
+            {
+                _values = new FieldValue[(int)HudField.Count];
+            }
+
+            return (_known & (1 << (int)field)) != 0;
+        }
+
+        private FieldValue ReadField(HudField field)
+        {
+            if (!IsKnown(field))
+            {
+                var name = _fieldNames[(int)field];
+
+                switch (_fieldTypes[(int)field])
+                {
+                    case VariableType.Float:
+                        _values[(int)field].vector.X = Entity.GetField<float>(name);
+                        break;
+                    case VariableType.Integer:
+                        _values[(int)field].integer = Entity.GetField<int>(name);
+                        break;
+                    case VariableType.String:
+                        _values[(int)field].text = Entity.GetField<string>(name);
+                        break;
+                    case VariableType.Vector:
+                        _values[(int)field].vector = Entity.GetField<Vector3>(name);
+                        break;
+                }
+
+                _known |= (1 << (int)field);
+            }
+
+            return _values[(int)field];
+        }
+
+        private void MarkDirty(HudField field)
+        {
+            if (_dirty == 0)
+            {
+                _dirtyElems.Add(this);
+            }
+
+            _known |= (1 << (int)field);
+            _dirty |= (1 << (int)field);
+        }
+
+        // for fields set around the shadow, or changed by the game itself
+        private void ForgetField(string name)
+        {
+            int index = Array.IndexOf(_fieldNames, name.ToLowerInvariant());
+
+            if (index >= 0)
+            {
+                _known &= ~(1 << index);
+                _dirty &= ~(1 << index);
+            }
+        }
+
+        // makes the next reads of the mirrored fields come from the game again
+        public void Refresh()
+        {
+            _known = _dirty;
+        }
+
+        // sends the changed fields of all elements to the game in a single call
+        internal static void FlushAll()
+        {
+            if (_dirtyElems.Count == 0)
+            {
+                return;
+            }
+
+            if (_fieldIDs == null)
+            {
+                _fieldIDs = _fieldNames.Select(name => ScriptField.Get(name).Identifier).ToArray();
+            }
+
+            int count = 0;
+            int numStrings = 0;
+
+            foreach (var elem in _dirtyElems)
+            {
+                // destroyed, or forgotten since
+                if (elem._dirty == 0 || elem.Entity == null)
+                {
+                    continue;
+                }
+
+                for (int i = 0; i < (int)HudField.Count; i++)
+                {
+                    if ((elem._dirty & (1 << i)) == 0 || _fieldIDs[i] == -1)
+                    {
+                        continue;
+                    }
+
+                    if (count == _updates.Length)
+                    {
+                        Array.Resize(ref _updates, _updates.Length * 2);
+                    }
+
+                    var value = elem._values[i];
+                    var type = _fieldTypes[i];
+
+                    _updates[count].entRef = elem.Entity.EntRef;
+                    _updates[count].fieldID = _fieldIDs[i];
+                    _updates[count].type = type;
+                    _updates[count].vector = value.vector;
+                    _updates[count].integer = value.integer;
+
+                    if (type == VariableType.String)
+                    {
+                        if (numStrings == _updateStrings.Length)
+                        {
+                            Array.Resize(ref _updateStrings, _updateStrings.Length * 2);
+                        }
+
+                        _updateStrings[numStrings] = value.text ?? "";
+                        _updates[count].integer = numStrings;
+                        numStrings++;
+                    }
+
+                    count++;
+                }
+
+                elem._dirty = 0;
+            }
+
+            _dirtyElems.Clear();
+
+            if (count > 0)
+            {
+                GameInterface.Script_SetFields(count, _updates, _updateStrings);
+            }
+
+            Array.Clear(_updateStrings, 0, numStrings);
+        }
+
+        internal static void ClearAll()
+        {
+            foreach (var elem in _dirtyElems)
+            {
+                elem._dirty = 0;
+            }
+
+            _dirtyElems.Clear();
+            _hudElems.Clear();
+        }
+
+        // called by Function for a destroy through any path; pending fields would land on the next element in the slot
+        internal static void Forget(int entRef)
+        {
+            HudElem elem;
+
+            if (_hudElems.TryGetValue(entRef, out elem))
+            {
+                elem._known = 0;
+                elem._dirty = 0;
+                _hudElems.Remove(entRef);
+            }
+
+            // references kept to the destroyed element see it as invalid, and the slot gets a new entity once reused
+            Entity.RemoveEntity(entRef);
+        }
+
+        // functions may depend on the fields set before them, like moveovertime does
+        private void BeforeCall(string func)
+        {
+            // no point in sending fields to an element about to go away
+            if (func != null && func.Equals("destroy", StringComparison.OrdinalIgnoreCase))
+            {
+                return;
+            }
+
+            if (_dirty != 0)
+            {
+                FlushAll();
+            }
+        }
+        #endregion
+
         #region calls
         public void Call(string func, params Parameter[] parameters)
         {
+            BeforeCall(func);
             Function.SetEntRef(Entity.EntRef);
             Function.Call(func, parameters);
         }
 
         public void Call(int identifier, params Parameter[] parameters)
         {
+            BeforeCall(null);
             Function.SetEntRef(Entity.EntRef);
             Function.Call(identifier, parameters);
         }
 
         public TReturn Call<TReturn>(string func, params Parameter[] parameters)
         {
+            BeforeCall(func);
             Function.SetEntRef(Entity.EntRef);
             return Function.Call<TReturn>(func, parameters);
         }
 
         public TReturn Call<TReturn>(int identifier, params Parameter[] parameters)
         {
+            BeforeCall(null);
             Function.SetEntRef(Entity.EntRef);
             return Function.Call<TReturn>(identifier, parameters);
         }
@@ -322,8 +666,20 @@ namespace InfinityScript
 
         public void SetField(string name, Parameter value)
         {
+            ForgetField(name);
             Entity.SetField(name, value);
         }
+
+        public T GetField<T>(ScriptField field)
+        {
+            return Entity.GetField<T>(field);
+        }
+
+        public void SetField(ScriptField field, Parameter value)
+        {
+            ForgetField(field.Name);
+            Entity.SetField(field, value);
+        }
         #endregion
 
         public static HudElem CreateFontString(Entity client, string font, float fontScale)
@@ -0,0 +1,218 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // the state of all players, filled by the game in a single call instead of a call per player and field
+    public sealed class PlayerSnapshot
+    {
+        public const int MaxClients = 18;
+
+        private const int ConnectedFlag = 1;
+        private const int AliveFlag = 2;
+
+        // indexed by the team number the game returns
+        private static readonly string[] _teamNames = new[] { "none", "axis", "allies", "spectator" };
+
+        private static PlayerSnapshot _current = new PlayerSnapshot();
+        private static bool _currentStale = true;
+
+        private int[] _flags = new int[MaxClients];
+        private float[] _origins = new float[MaxClients * 3];
+        private float[] _angles = new float[MaxClients * 3];
+        private int[] _health = new int[MaxClients];
+        private int[] _teams = new int[MaxClients];
+        private int[] _pings = new int[MaxClients];
+        private int _numClients;
+
+        // the snapshot of the current frame, it only gets read from the game the first time it's used in a frame
+        public static PlayerSnapshot Current
+        {
+            get
+            {
+                ScriptWorker.AssertMainThread();
+
+                if (_currentStale)
+                {
+                    _current.Update();
+                    _currentStale = false;
+                }
+
+                return _current;
+            }
+        }
+
+        internal static void Invalidate()
+        {
+            _currentStale = true;
+        }
+
+        // reads the state of all players again, for when a script needs it to be up to date within a frame
+        public void Update()
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
+            _numClients = GameInterface.GetPlayerSnapshot(MaxClients, _flags, _origins, _angles, _health, _teams, _pings);
+        }
+
+        public int NumClients
+        {
+            get
+            {
+                return _numClients;
+            }
+        }
+
+        public PlayerState this[int clientNum]
+        {
+            get
+            {
+                if (clientNum < 0 || clientNum >= MaxClients)
+                {
+                    throw new ArgumentOutOfRangeException("clientNum");
+                }
+
+                return new PlayerState(this, clientNum);
+            }
+        }
+
+        public PlayerState this[Entity player]
+        {
+            get
+            {
+                return this[player.EntRef];
+            }
+        }
+
+        internal bool HasFlag(int clientNum, int flag)
+        {
+            return (clientNum < _numClients && (_flags[clientNum] & flag) != 0);
+        }
+
+        internal bool IsConnected(int clientNum)
+        {
+            return HasFlag(clientNum, ConnectedFlag);
+        }
+
+        internal bool IsAlive(int clientNum)
+        {
+            return HasFlag(clientNum, AliveFlag);
+        }
+
+        internal Vector3 GetOrigin(int clientNum)
+        {
+            return new Vector3(_origins[clientNum * 3], _origins[clientNum * 3 + 1], _origins[clientNum * 3 + 2]);
+        }
+
+        internal Vector3 GetAngles(int clientNum)
+        {
+            return new Vector3(_angles[clientNum * 3], _angles[clientNum * 3 + 1], _angles[clientNum * 3 + 2]);
+        }
+
+        internal int GetHealth(int clientNum)
+        {
+            return _health[clientNum];
+        }
+
+        internal string GetTeam(int clientNum)
+        {
+            int team = _teams[clientNum];
+
+            return (team >= 0 && team < _teamNames.Length) ? _teamNames[team] : "";
+        }
+
+        internal int GetPing(int clientNum)
+        {
+            return _pings[clientNum];
+        }
+    }
+
+    // a view on a single player in a snapshot; the values are only meaningful if the player is connected
+    public struct PlayerState
+    {
+        private readonly PlayerSnapshot _snapshot;
+        private readonly int _clientNum;
+
+        internal PlayerState(PlayerSnapshot snapshot, int clientNum)
+        {
+            _snapshot = snapshot;
+            _clientNum = clientNum;
+        }
+
+        public int ClientNum
+        {
+            get
+            {
+                return _clientNum;
+            }
+        }
+
+        public Entity Entity
+        {
+            get
+            {
+                return Entity.GetEntity(_clientNum);
+            }
+        }
+
+        public bool IsConnected
+        {
+            get
+            {
+                return _snapshot.IsConnected(_clientNum);
+            }
+        }
+
+        public bool IsAlive
+        {
+            get
+            {
+                return _snapshot.IsAlive(_clientNum);
+            }
+        }
+
+        public Vector3 Origin
+        {
+            get
+            {
+                return _snapshot.GetOrigin(_clientNum);
+            }
+        }
+
+        public Vector3 Angles
+        {
+            get
+            {
+                return _snapshot.GetAngles(_clientNum);
+            }
+        }
+
+        public int Health
+        {
+            get
+            {
+                return _snapshot.GetHealth(_clientNum);
+            }
+        }
+
+        // same as the sessionteam field
+        public string Team
+        {
+            get
+            {
+                return _snapshot.GetTeam(_clientNum);
+            }
+        }
+
+        public int Ping
+        {
+            get
+            {
+                return _snapshot.GetPing(_clientNum);
+            }
+        }
+    }
+}
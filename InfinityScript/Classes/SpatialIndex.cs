@@ -0,0 +1,158 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    [Flags]
+    public enum SpatialTypes
+    {
+        Players = 1,
+        Entities = 2,
+        All = Players | Entities
+    }
+
+    // finds entities near a point from a grid the game keeps, instead of looping over every entity in script
+    public static class SpatialIndex
+    {
+        private const int MaxResults = 2048;
+
+        // the grid gets rebuilt by the first query after this changes
+        private static int _frame;
+
+        private static int[] _results = new int[MaxResults];
+
+        // adds a script entity (a pickup, a trigger, a spawned model) to the queries; players are always in them
+        public static void Track(Entity entity)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            GameInterface.SpatialTrack(entity.EntRef, 1);
+        }
+
+        public static void Untrack(Entity entity)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            GameInterface.SpatialTrack(entity.EntRef, 0);
+        }
+
+        public static List<Entity> InRadius(Vector3 center, float radius)
+        {
+            return InRadius(center, radius, SpatialTypes.All);
+        }
+
+        public static List<Entity> InRadius(Vector3 center, float radius, SpatialTypes types)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var count = GameInterface.SpatialRadius(_frame, (int)types, ref center, radius, _results, MaxResults);
+
+            return ToList(count);
+        }
+
+        // fills entities and returns the number found, without allocating
+        public static int InRadius(Vector3 center, float radius, SpatialTypes types, Entity[] entities)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var count = GameInterface.SpatialRadius(_frame, (int)types, ref center, radius, _results, Math.Min(entities.Length, MaxResults));
+
+            return ToArray(count, entities);
+        }
+
+        // the closest entities, closest first
+        public static List<Entity> Nearest(Vector3 center, int count, float maxDistance)
+        {
+            return Nearest(center, count, maxDistance, SpatialTypes.All);
+        }
+
+        public static List<Entity> Nearest(Vector3 center, int count, float maxDistance, SpatialTypes types)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var found = GameInterface.SpatialNearest(_frame, (int)types, ref center, maxDistance, _results, Math.Min(count, MaxResults));
+
+            return ToList(found);
+        }
+
+        public static int Nearest(Vector3 center, float maxDistance, SpatialTypes types, Entity[] entities)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var found = GameInterface.SpatialNearest(_frame, (int)types, ref center, maxDistance, _results, Math.Min(entities.Length, MaxResults));
+
+            return ToArray(found, entities);
+        }
+
+        // the entities with their origin inside the box
+        public static List<Entity> InBox(Vector3 mins, Vector3 maxs)
+        {
+            return InBox(mins, maxs, SpatialTypes.All);
+        }
+
+        public static List<Entity> InBox(Vector3 mins, Vector3 maxs, SpatialTypes types)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var count = GameInterface.SpatialBox(_frame, (int)types, ref mins, ref maxs, _results, MaxResults);
+
+            return ToList(count);
+        }
+
+        public static int InBox(Vector3 mins, Vector3 maxs, SpatialTypes types, Entity[] entities)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+            var count = GameInterface.SpatialBox(_frame, (int)types, ref mins, ref maxs, _results, Math.Min(entities.Length, MaxResults));
+
+            return ToArray(count, entities);
+        }
+
+        // makes the next query read the positions again, for when entities moved within a frame
+        public static void Refresh()
+        {
+            Invalidate();
+        }
+
+        internal static void Invalidate()
+        {
+            _frame++;
+        }
+
+        // called by Function for a delete through any path, as the entity number goes to the next entity spawned
+        internal static void Forget(int entRef)
+        {
+            GameInterface.SpatialTrack(entRef, 0);
+        }
+
+        internal static void Clear()
+        {
+            GameInterface.SpatialReset();
+            _frame++;
+        }
+
+        private static List<Entity> ToList(int count)
+        {
+            var entities = new List<Entity>(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                entities.Add(Entity.GetEntity(_results[i]));
+            }
+
+            return entities;
+        }
+
+        private static int ToArray(int count, Entity[] entities)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                entities[i] = Entity.GetEntity(_results[i]);
+            }
+
+            return count;
+        }
+    }
+}
@@ -261,11 +261,17 @@ namespace InfinityScript
 
         public static void SetDropItemEnabled(bool enabled)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             GameInterface.SetDropItemEnabled(enabled);
         }
 
         public static Entity AddTestClient()
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             var entref = GameInterface.AddTestClient();
 
             if (entref == 0)
@@ -278,6 +284,9 @@ namespace InfinityScript
 
         public static void ExecuteCommand(string command)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             GameInterface.Cbuf_AddText(command + "\n");
         }
 
@@ -315,6 +324,9 @@ namespace InfinityScript
 
         public static void RawSayAll(string message)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             GameInterface.SV_GameSendServerCommand(-1, -1, message);
         }
         public static void RawSayTo(Entity ent, string message)
@@ -323,23 +335,20 @@ namespace InfinityScript
         }
         public static void RawSayTo(int entref, string message)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             GameInterface.SV_GameSendServerCommand(entref, -1, message);
         }
         #endregion
 
         public static string[] Tokenize(string line)
         {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
             GameInterface.Cmd_TokenizeString(line);
-            var argc = GameInterface.Cmd_Argc();
-            if(argc == 0)
-            {
-                return new string[0];
-            }
-            var tokenized = new string[argc];
-            for (int i = 0; i < argc; i++)
-            {
-                tokenized[i] = GameInterface.Cmd_Argv(i);
-            }
+            var tokenized = GameInterface.Cmd_Args();
             GameInterface.Cmd_EndTokenizedString();
             return tokenized;
         }
@@ -70,7 +70,9 @@ namespace InfinityScript.Examples
 
                 entity.OnInterval(4000, player =>
                 {
-                    if (!player.IsAlive)
+                    var state = PlayerSnapshot.Current[player];
+
+                    if (!state.IsAlive)
                     {
                         return true;
                     }
@@ -104,7 +106,7 @@ namespace InfinityScript.Examples
                     {
                         var lastPos = player.GetField<Vector3>("ac_lastPos");
 
-                        if (lastPos.DistanceTo2D(player.Origin) < 50)
+                        if (lastPos.DistanceTo2D(state.Origin) < 50)
                         {
                             player.Call("iprintlnbold", "You will be killed if you do not move.");
 
@@ -119,7 +121,7 @@ namespace InfinityScript.Examples
                         }
                     }
 
-                    player.SetField("ac_lastPos", player.Origin);
+                    player.SetField("ac_lastPos", state.Origin);
 
                     return true;
                 });
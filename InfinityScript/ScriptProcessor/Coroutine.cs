@@ -0,0 +1,207 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    internal enum WaitType
+    {
+        NextFrame = 0,
+        Time = 1,
+        Notify = 2
+    }
+
+    // what a coroutine waits for until it continues; a struct so that yielding it doesn't allocate
+    public struct WaitRequest
+    {
+        internal WaitType type;
+        internal int time;
+        internal Notifiable target;
+        internal string notify;
+        internal NotifyResult result;
+
+        internal WaitRequest(WaitType type, int time, Notifiable target, string notify, NotifyResult result)
+        {
+            this.type = type;
+            this.time = time;
+            this.target = target;
+            this.notify = notify;
+            this.result = result;
+        }
+    }
+
+    // receives the arguments of the notify a coroutine waited for
+    public sealed class NotifyResult
+    {
+        public Parameter[] Parameters { get; internal set; }
+    }
+
+    // a script thread written as an iterator, continuing after each yielded WaitRequest like a GSC thread after a wait
+    public sealed class Coroutine
+    {
+        private Notifiable _owner;
+        private IEnumerator<WaitRequest> _routine;
+        private bool _running;
+
+        // reused for every timed wait
+        private ScriptTimer _timer;
+
+        private Notifiable _waitTarget;
+        private string _waitNotify;
+        private NotifyResult _waitResult;
+
+        private Type _script;
+
+        // looked up on the first profiled run
+        private ProfileEntry _profile;
+
+        internal Coroutine(Notifiable owner, IEnumerator<WaitRequest> routine)
+        {
+            _owner = owner;
+            _routine = routine;
+            _running = true;
+            _script = ScriptProfiler.GetScriptType(routine.GetType());
+        }
+
+        public bool IsRunning
+        {
+            get
+            {
+                return _running;
+            }
+        }
+
+        public void Cancel()
+        {
+            if (!_running)
+            {
+                return;
+            }
+
+            _running = false;
+
+            if (_timer != null && _timer.heapIndex >= 0)
+            {
+                TimerScheduler.Cancel(_timer);
+            }
+
+            StopWaiting();
+
+            _routine.Dispose();
+        }
+
+        internal void Resume()
+        {
+            if (!_running)
+            {
+                return;
+            }
+
+            // the entity running it went away, or its script got disabled
+            if (_owner._timersStopped || ScriptWatchdog.IsDisabled(_script))
+            {
+                Cancel();
+                return;
+            }
+
+            var sample = ScriptProfiler.Begin();
+            bool waiting;
+
+            ScriptWatchdog.Enter(_script, "Coroutine", _routine.GetType());
+
+            try
+            {
+                waiting = _routine.MoveNext();
+            }
+            catch (Exception ex)
+            {
+                if (!ScriptWatchdog.HandleAbort(ex))
+                {
+                    Log.Write(LogLevel.Error, "Exception in coroutine {0} of {1}: {2}", _routine.GetType().Name, _owner, ex.ToString());
+                }
+
+                waiting = false;
+            }
+            finally
+            {
+                ScriptWatchdog.Exit();
+            }
+
+            if (sample.Timestamp != 0 && _profile == null)
+            {
+                _profile = ScriptProfiler.GetEntry(_script, "Coroutine " + _routine.GetType().Name);
+            }
+
+            ScriptProfiler.End(_profile, sample);
+
+            // finished, or cancelled from within
+            if (!waiting || !_running)
+            {
+                Cancel();
+                return;
+            }
+
+            var wait = _routine.Current;
+
+            switch (wait.type)
+            {
+                case WaitType.Time:
+                    if (_timer == null)
+                    {
+                        _timer = new ScriptTimer(_owner, owner =>
+                        {
+                            Resume();
+                            return false;
+                        });
+                    }
+
+                    TimerScheduler.Reschedule(_timer, TimerScheduler.CurrentTime + wait.time);
+                    break;
+                case WaitType.Notify:
+                    // waiting on an entity that went away already
+                    if (wait.target._timersStopped)
+                    {
+                        Cancel();
+                        break;
+                    }
+
+                    _waitTarget = wait.target;
+                    _waitNotify = wait.notify;
+                    _waitResult = wait.result;
+
+                    _waitTarget.AddWaiter(_waitNotify, this);
+                    break;
+                default:
+                    CoroutineScheduler.ResumeNextFrame(this);
+                    break;
+            }
+        }
+
+        internal void ResumeNotify(Parameter[] parameters)
+        {
+            if (_waitResult != null)
+            {
+                _waitResult.Parameters = parameters;
+            }
+
+            _waitTarget = null;
+            _waitNotify = null;
+            _waitResult = null;
+
+            Resume();
+        }
+
+        private void StopWaiting()
+        {
+            if (_waitTarget != null)
+            {
+                _waitTarget.RemoveWaiter(_waitNotify, this);
+
+                _waitTarget = null;
+                _waitNotify = null;
+                _waitResult = null;
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // continues the coroutines waiting for the next frame; timed and notify waits go through the timers and notifies
+    internal static class CoroutineScheduler
+    {
+        private static List<Coroutine> _nextFrame = new List<Coroutine>();
+        private static List<Coroutine> _thisFrame = new List<Coroutine>();
+
+        public static void ResumeNextFrame(Coroutine coroutine)
+        {
+            _nextFrame.Add(coroutine);
+        }
+
+        public static void RunFrame()
+        {
+            // coroutines waiting for a frame again go in the other list
+            var coroutines = _nextFrame;
+            _nextFrame = _thisFrame;
+            _thisFrame = coroutines;
+
+            for (int i = 0; i < coroutines.Count; i++)
+            {
+                coroutines[i].Resume();
+            }
+
+            coroutines.Clear();
+        }
+
+        public static void Clear()
+        {
+            _nextFrame.Clear();
+            _thisFrame.Clear();
+        }
+    }
+}
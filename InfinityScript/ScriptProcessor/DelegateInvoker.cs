@@ -0,0 +1,204 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // builds the typed callers used to dispatch notify and timer handlers, so that
+    // reflection only happens once, when the handler gets registered
+    internal static class DelegateInvoker
+    {
+        public static Action<Notifiable, Parameter[]> CreateNotifyInvoker(Delegate handler)
+        {
+            if (handler is Action)
+            {
+                var func = (Action)handler;
+                return (self, p) => func();
+            }
+
+            if (handler is Action<Parameter>)
+            {
+                var func = (Action<Parameter>)handler;
+                return (self, p) => func(p[0]);
+            }
+
+            if (handler is Action<Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4], p[5]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8]);
+            }
+
+            if (handler is Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+            }
+
+            if (handler is Action<Entity>)
+            {
+                var func = (Action<Entity>)handler;
+                return (self, p) => func(self as Entity);
+            }
+
+            if (handler is Action<Entity, Parameter>)
+            {
+                var func = (Action<Entity, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4], p[5]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8]);
+            }
+
+            if (handler is Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)
+            {
+                var func = (Action<Entity, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter, Parameter>)handler;
+                return (self, p) => func(self as Entity, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9]);
+            }
+
+            // unknown delegate type, fall back to a dynamic call
+            var parameters = handler.Method.GetParameters();
+
+            if (parameters.Length > 0 && parameters[0].ParameterType == typeof(Entity))
+            {
+                return (self, p) =>
+                {
+                    var newParameters = new object[p.Length + 1];
+                    newParameters[0] = self as Entity;
+                    Array.Copy(p, 0, newParameters, 1, p.Length);
+
+                    handler.DynamicInvoke(newParameters);
+                };
+            }
+
+            return (self, p) => handler.DynamicInvoke(p);
+        }
+
+        // the returned function returns false if the timer has to be stopped
+        public static Func<Notifiable, bool> CreateTimerInvoker(Delegate function)
+        {
+            if (function is Func<bool>)
+            {
+                var func = (Func<bool>)function;
+                return self => func();
+            }
+
+            if (function is Action)
+            {
+                var func = (Action)function;
+                return self => { func(); return true; };
+            }
+
+            if (function is Func<Entity, bool>)
+            {
+                var func = (Func<Entity, bool>)function;
+                return self => func(self as Entity);
+            }
+
+            if (function is Action<Entity>)
+            {
+                var func = (Action<Entity>)function;
+                return self => { func(self as Entity); return true; };
+            }
+
+            // unknown delegate type, fall back to a dynamic call
+            var parameters = function.Method.GetParameters();
+            var returnsBool = (function.Method.ReturnType == typeof(bool));
+            var wantsEntity = (parameters.Length > 0 && parameters[0].ParameterType == typeof(Entity));
+
+            return self =>
+            {
+                var returnValue = (wantsEntity) ? function.DynamicInvoke(self) : function.DynamicInvoke();
+
+                return !(returnsBool && (bool)returnValue == false);
+            };
+        }
+    }
+}
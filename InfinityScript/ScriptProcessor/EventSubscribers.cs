@@ -0,0 +1,123 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // the subscribers of an event raised for notifies, like Notified or Entity.SpawnedPlayer; each one runs as a handler
+    // of the script that subscribed it, so the subscribers of a disabled or reloaded script get skipped
+    internal sealed class EventSubscribers
+    {
+        private string _name;
+
+        // replaced on every change, so that handlers can unsubscribe while the event is raised
+        private Delegate[] _handlers = new Delegate[0];
+        private ProfileEntry[] _profiles = new ProfileEntry[0];
+
+        public EventSubscribers(string name)
+        {
+            _name = name;
+        }
+
+        public bool IsEmpty
+        {
+            get
+            {
+                return _handlers.Length == 0;
+            }
+        }
+
+        public void Add(Delegate handler)
+        {
+            if (handler == null)
+            {
+                return;
+            }
+
+            // a multicast delegate subscribes each of its methods
+            var handlers = new List<Delegate>(_handlers);
+            var profiles = new List<ProfileEntry>(_profiles);
+
+            foreach (var method in handler.GetInvocationList())
+            {
+                handlers.Add(method);
+                profiles.Add(ScriptProfiler.GetEntry(method, _name));
+            }
+
+            _handlers = handlers.ToArray();
+            _profiles = profiles.ToArray();
+        }
+
+        // removes the last subscription of handler, like removing from a multicast delegate
+        public void Remove(Delegate handler)
+        {
+            if (handler == null)
+            {
+                return;
+            }
+
+            for (int i = _handlers.Length - 1; i >= 0; i--)
+            {
+                if (_handlers[i].Equals(handler))
+                {
+                    var handlers = new List<Delegate>(_handlers);
+                    var profiles = new List<ProfileEntry>(_profiles);
+
+                    handlers.RemoveAt(i);
+                    profiles.RemoveAt(i);
+
+                    _handlers = handlers.ToArray();
+                    _profiles = profiles.ToArray();
+                    return;
+                }
+            }
+        }
+
+        public void Raise(Notifiable owner, string type, Parameter[] parameters)
+        {
+            var handlers = _handlers;
+            var profiles = _profiles;
+
+            for (int i = 0; i < handlers.Length; i++)
+            {
+                var profile = profiles[i];
+
+                if (ScriptWatchdog.IsDisabled(profile.ScriptType))
+                {
+                    continue;
+                }
+
+                var sample = ScriptProfiler.Begin();
+                ScriptWatchdog.Enter(profile.ScriptType, profile.Handler);
+
+                try
+                {
+                    var notified = handlers[i] as Action<string, Parameter[]>;
+
+                    if (notified != null)
+                    {
+                        notified(type, parameters);
+                    }
+                    else
+                    {
+                        ((Action)handlers[i])();
+                    }
+                }
+                catch (Exception ex)
+                {
+                    if (!ScriptWatchdog.HandleAbort(ex))
+                    {
+                        Log.Write(LogLevel.Error, "Exception during {0} of {1} on {2}: {3}", _name, type, owner, ex.ToString());
+                    }
+                }
+                finally
+                {
+                    ScriptWatchdog.Exit();
+                }
+
+                ScriptProfiler.End(profile, sample);
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // the time scripts get each frame for work that can wait for the next frame, like pending notifies and due timers
+    internal static class FrameBudget
+    {
+        private static long _frameStart;
+        private static long _budgetTicks;
+        private static int _milliseconds;
+
+        static FrameBudget()
+        {
+            Milliseconds = 25;
+        }
+
+        // 0 for no budget
+        public static int Milliseconds
+        {
+            get
+            {
+                return _milliseconds;
+            }
+            set
+            {
+                _milliseconds = Math.Max(value, 0);
+                _budgetTicks = (_milliseconds * Stopwatch.Frequency) / 1000;
+            }
+        }
+
+        public static void StartFrame()
+        {
+            _frameStart = Stopwatch.GetTimestamp();
+        }
+
+        public static bool Exhausted
+        {
+            get
+            {
+                return _budgetTicks > 0 && (Stopwatch.GetTimestamp() - _frameStart) >= _budgetTicks;
+            }
+        }
+    }
+}
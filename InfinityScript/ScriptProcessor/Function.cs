@@ -8,37 +8,88 @@ namespace InfinityScript
 {
     public static class Function
     {
-        private static Dictionary<string, int> _functionMappings = new Dictionary<string, int>();
-        private static Dictionary<string, int> _globalFunctionMappings = new Dictionary<string, int>();
+        private static NameTable _functionMappings = new NameTable(new NameEntry[0]);
+        private static NameTable _globalFunctionMappings = new NameTable(new NameEntry[0]);
+
+        // hud elements destroyed and entities deleted through any call path drop their cached state
+        private static int _destroyIdentifier = -1;
+        private static int _deleteIdentifier = -1;
+
+        internal static void SetMappings(NameTable functionMappings, NameTable globalFunctionMappings)
+        {
+            _functionMappings = functionMappings;
+            _globalFunctionMappings = globalFunctionMappings;
+
+            if (!_functionMappings.TryGetValue("destroy", out _destroyIdentifier))
+            {
+                _destroyIdentifier = -1;
+            }
+
+            if (!_functionMappings.TryGetValue("delete", out _deleteIdentifier))
+            {
+                _deleteIdentifier = -1;
+            }
+        }
 
         public static void AddMapping(string name, int value)
         {
-            _functionMappings[name.ToLowerInvariant()] = value;
+            _functionMappings.Add(name, value);
+
+            if (name.Equals("destroy", StringComparison.OrdinalIgnoreCase))
+            {
+                _destroyIdentifier = value;
+            }
+            else if (name.Equals("delete", StringComparison.OrdinalIgnoreCase))
+            {
+                _deleteIdentifier = value;
+            }
         }
 
         public static void AddGlobalMapping(string name, int value)
         {
-            _globalFunctionMappings[name.ToLowerInvariant()] = value;
+            _globalFunctionMappings.Add(name, value);
         }
 
         public static bool IsFunction(string name)
         {
-            return (_functionMappings.ContainsKey(name.ToLowerInvariant()) || _globalFunctionMappings.ContainsKey(name.ToLowerInvariant()));
+            return (_functionMappings.ContainsKey(name) || _globalFunctionMappings.ContainsKey(name));
+        }
+
+        internal static ScriptFunction Resolve(string name)
+        {
+            int identifier;
+            int instanceIdentifier = (_functionMappings.TryGetValue(name, out identifier)) ? identifier : -1;
+            int globalIdentifier = (_globalFunctionMappings.TryGetValue(name, out identifier)) ? identifier : -1;
+
+            return new ScriptFunction(name.ToLowerInvariant(), instanceIdentifier, globalIdentifier);
         }
 
         private static int _entRef;
 
-        private static object _returnValue;
+        private static Parameter _returnValue;
+
+        // set while the game's return stack of a call still has to be cleaned
+        private static bool _returnPending;
 
         public static void SetEntRef(int entRef)
         {
             _entRef = entRef;
         }
 
-        public static void Call(string func, params Parameter[] parameters)
+        // puts the call state back after a handler got aborted, which could have been in the middle of a call
+        internal static void ResetCallState()
         {
-            func = func.ToLowerInvariant();
+            SetEntRef(-1);
+
+            if (_returnPending)
+            {
+                _returnPending = false;
+                GameInterface.Script_CleanReturnStack();
+            }
+        }
 
+        private static bool TryGetIdentifier(string func, out int identifier)
+        {
             var table = _globalFunctionMappings;
 
             if (_entRef != -1)
@@ -46,13 +97,36 @@ namespace InfinityScript
                 table = _functionMappings;
             }
 
-            if (!table.ContainsKey(func))
+            if (!table.TryGetValue(func, out identifier))
+            {
+                Log.Write(LogLevel.Warning, "no such function: {0}", func.ToLowerInvariant());
+                return false;
+            }
+
+            return true;
+        }
+
+        private static bool TryGetIdentifier(ScriptFunction func, out int identifier)
+        {
+            identifier = (_entRef != -1) ? func.InstanceIdentifier : func.GlobalIdentifier;
+
+            if (identifier == -1)
             {
-                Log.Write(LogLevel.Warning, "no such function: {0}", func);
-                return;
+                Log.Write(LogLevel.Warning, "no such function: {0}", func.Name);
+                return false;
             }
 
-            Call(table[func], parameters);
+            return true;
+        }
+
+        public static void Call(string func, params Parameter[] parameters)
+        {
+            int identifier;
+
+            if (TryGetIdentifier(func, out identifier))
+            {
+                CallRaw(identifier, parameters);
+            }
         }
 
         public static void Call(int identifier, params Parameter[] parameters)
@@ -62,54 +136,187 @@ namespace InfinityScript
 
         public static TReturn Call<TReturn>(string func, params Parameter[] parameters)
         {
-            func = func.ToLowerInvariant();
+            int identifier;
 
-            var table = _globalFunctionMappings;
+            if (!TryGetIdentifier(func, out identifier))
+            {
+                return default(TReturn);
+            }
 
-            if (_entRef != -1)
+            CallRaw(identifier, parameters);
+
+            return _returnValue.As<TReturn>();
+        }
+
+        public static TReturn Call<TReturn>(int identifier, params Parameter[] parameters)
+        {
+            CallRaw(identifier, parameters);
+
+            return _returnValue.As<TReturn>();
+        }
+
+        public static void Call(ScriptFunction func, params Parameter[] parameters)
+        {
+            int identifier;
+
+            if (TryGetIdentifier(func, out identifier))
             {
-                table = _functionMappings;
+                CallRaw(identifier, parameters);
             }
+        }
 
-            if (!table.ContainsKey(func))
+        public static TReturn Call<TReturn>(ScriptFunction func, params Parameter[] parameters)
+        {
+            int identifier;
+
+            if (!TryGetIdentifier(func, out identifier))
             {
-                Log.Write(LogLevel.Warning, "no such function: {0}", func);
                 return default(TReturn);
             }
 
-            return Call<TReturn>(table[func], parameters);
+            CallRaw(identifier, parameters);
+
+            return _returnValue.As<TReturn>();
         }
 
-        public static TReturn Call<TReturn>(int identifier, params Parameter[] parameters)
+        #region fixed argument counts
+        // these avoid the params array: the arguments go straight to the script stack
+        public static void Call(string func)
         {
-            object retval = Call(identifier, typeof(TReturn), parameters);
+            CallFixed(func, 0, default(Parameter), default(Parameter), default(Parameter));
+        }
 
-            return (TReturn)retval;
+        public static void Call(string func, Parameter arg1)
+        {
+            CallFixed(func, 1, arg1, default(Parameter), default(Parameter));
         }
 
-        private static object Call(int identifier, Type returnType, params Parameter[] parameters)
+        public static void Call(string func, Parameter arg1, Parameter arg2)
         {
-            CallRaw(identifier, parameters);
+            CallFixed(func, 2, arg1, arg2, default(Parameter));
+        }
+
+        public static void Call(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            CallFixed(func, 3, arg1, arg2, arg3);
+        }
+
+        public static TReturn Call<TReturn>(string func)
+        {
+            return CallFixed<TReturn>(func, 0, default(Parameter), default(Parameter), default(Parameter));
+        }
+
+        public static TReturn Call<TReturn>(string func, Parameter arg1)
+        {
+            return CallFixed<TReturn>(func, 1, arg1, default(Parameter), default(Parameter));
+        }
+
+        public static TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2)
+        {
+            return CallFixed<TReturn>(func, 2, arg1, arg2, default(Parameter));
+        }
+
+        public static TReturn Call<TReturn>(string func, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            return CallFixed<TReturn>(func, 3, arg1, arg2, arg3);
+        }
 
-            return _returnValue;
+        private static void CallFixed(string func, int numArgs, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            int identifier;
+
+            if (TryGetIdentifier(func, out identifier))
+            {
+                CallRaw(identifier, numArgs, arg1, arg2, arg3);
+            }
         }
 
-        private static void CallRaw(int identifier, params Parameter[] parameters)
+        private static TReturn CallFixed<TReturn>(string func, int numArgs, Parameter arg1, Parameter arg2, Parameter arg3)
         {
-            // push arguments
-            foreach (var parameter in parameters.Reverse())
+            int identifier;
+
+            if (!TryGetIdentifier(func, out identifier))
+            {
+                return default(TReturn);
+            }
+
+            CallRaw(identifier, numArgs, arg1, arg2, arg3);
+
+            return _returnValue.As<TReturn>();
+        }
+        #endregion
+
+        private static void CallRaw(int identifier, Parameter[] parameters)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
+            // a thread abort waits for finally blocks, so it can't leave arguments pushed or the return stack uncleaned
+            try
+            {
+            }
+            finally
+            {
+                // push arguments
+                for (int i = parameters.Length - 1; i >= 0; i--)
+                {
+                    parameters[i].PushValue();
+                }
+
+                CallPushed(identifier, parameters.Length);
+            }
+        }
+
+        private static void CallRaw(int identifier, int numArgs, Parameter arg1, Parameter arg2, Parameter arg3)
+        {
+            ScriptWorker.AssertMainThread();
+            ScriptWatchdog.CheckAbort();
+
+            try
+            {
+            }
+            finally
+            {
+                // push arguments, last one first
+                if (numArgs >= 3)
+                {
+                    arg3.PushValue();
+                }
+
+                if (numArgs >= 2)
+                {
+                    arg2.PushValue();
+                }
+
+                if (numArgs >= 1)
+                {
+                    arg1.PushValue();
+                }
+
+                CallPushed(identifier, numArgs);
+            }
+        }
+
+        private static void CallPushed(int identifier, int numArgs)
+        {
+            if (identifier == _destroyIdentifier && _entRef != -1)
+            {
+                HudElem.Forget(_entRef);
+            }
+            else if (identifier == _deleteIdentifier && _entRef != -1)
             {
-                parameter.PushValue();
+                SpatialIndex.Forget(_entRef);
             }
 
             // call the function
-            GameInterface.Script_Call(identifier, _entRef, parameters.Length);
+            GameInterface.Script_Call(identifier, _entRef, numArgs);
+            _returnPending = true;
 
             // reset the entref to 0
             SetEntRef(-1);
 
             // check for return values
-            _returnValue = null;
+            _returnValue = default(Parameter);
 
             if (GameInterface.Notify_NumArgs() == 1)
             {
@@ -135,6 +342,7 @@ namespace InfinityScript
                 }
             }
 
+            _returnPending = false;
             GameInterface.Script_CleanReturnStack();
         }
     }
@@ -0,0 +1,271 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    internal struct NameEntry
+    {
+        public string Name;
+        public int Value;
+
+        public NameEntry(string name, int value)
+        {
+            Name = name;
+            Value = value;
+        }
+    }
+
+    // read-only, case-insensitive name -> id table, built once using a perfect hash (hash and displace):
+    // a lookup is one pass over the name and one comparison, without lowercasing the name first
+    internal sealed class NameTable
+    {
+        private string[] _keys;
+        private int[] _values;
+        private int[] _seeds;
+        private int _mask;
+        private int _bucketMask;
+
+        // names added after the table got built
+        private Dictionary<string, int> _additions;
+
+        public NameTable(IEnumerable<NameEntry> entries)
+            : this(entries.ToArray(), 0, null)
+        {
+        }
+
+        // size and seeds come from a previous build of the same entries (see Size and Seeds), so that
+        // the entries only have to be put in their slots; if they don't match anymore, the table is built again
+        public NameTable(NameEntry[] entries, int size, int[] seeds)
+        {
+            if (seeds != null && size > 0 && TryPlace(entries, size, seeds))
+            {
+                return;
+            }
+
+            // later entries override earlier ones with the same name
+            var unique = new Dictionary<string, int>(StringComparer.OrdinalIgnoreCase);
+
+            foreach (var entry in entries)
+            {
+                unique[entry.Name] = entry.Value;
+            }
+
+            // keep the table at most half full, so that the buckets find free slots quickly
+            size = 2;
+
+            while (size < unique.Count * 2)
+            {
+                size <<= 1;
+            }
+
+            while (!TryBuild(unique, size))
+            {
+                size <<= 1;
+            }
+        }
+
+        internal int Size
+        {
+            get
+            {
+                return _keys.Length;
+            }
+        }
+
+        internal int[] Seeds
+        {
+            get
+            {
+                return _seeds;
+            }
+        }
+
+        private bool TryPlace(NameEntry[] entries, int size, int[] seeds)
+        {
+            _keys = new string[size];
+            _values = new int[size];
+            _seeds = seeds;
+            _mask = size - 1;
+            _bucketMask = seeds.Length - 1;
+
+            foreach (var entry in entries)
+            {
+                uint hash = Hash(entry.Name);
+                int slot = Slot(hash, _seeds[Mix(hash) & _bucketMask]);
+
+                if (_keys[slot] != null && !string.Equals(_keys[slot], entry.Name, StringComparison.OrdinalIgnoreCase))
+                {
+                    return false;
+                }
+
+                _keys[slot] = entry.Name;
+                _values[slot] = entry.Value;
+            }
+
+            return true;
+        }
+
+        private bool TryBuild(Dictionary<string, int> entries, int size)
+        {
+            int numBuckets = 1;
+
+            while (numBuckets * 4 < entries.Count)
+            {
+                numBuckets <<= 1;
+            }
+
+            _keys = new string[size];
+            _values = new int[size];
+            _seeds = new int[numBuckets];
+            _mask = size - 1;
+            _bucketMask = numBuckets - 1;
+
+            // the names are only hashed once, trying a seed just remixes their hash
+            var buckets = new List<KeyValuePair<string, uint>>[numBuckets];
+
+            for (int i = 0; i < numBuckets; i++)
+            {
+                buckets[i] = new List<KeyValuePair<string, uint>>();
+            }
+
+            foreach (var name in entries.Keys)
+            {
+                uint hash = Hash(name);
+                buckets[Mix(hash) & _bucketMask].Add(new KeyValuePair<string, uint>(name, hash));
+            }
+
+            // place the largest buckets first, while there's still a lot of free slots
+            var order = Enumerable.Range(0, numBuckets).OrderByDescending(i => buckets[i].Count).ToArray();
+            var slots = new int[order.Length == 0 ? 0 : buckets[order[0]].Count];
+
+            foreach (var bucketIndex in order)
+            {
+                var bucket = buckets[bucketIndex];
+
+                if (bucket.Count == 0)
+                {
+                    break;
+                }
+
+                bool placed = false;
+                int seed;
+
+                for (seed = 1; seed < 0x10000; seed++)
+                {
+                    placed = true;
+
+                    for (int i = 0; i < bucket.Count && placed; i++)
+                    {
+                        slots[i] = Slot(bucket[i].Value, seed);
+
+                        if (_keys[slots[i]] != null || Array.IndexOf(slots, slots[i], 0, i) != -1)
+                        {
+                            placed = false;
+                        }
+                    }
+
+                    if (placed)
+                    {
+                        break;
+                    }
+                }
+
+                if (!placed)
+                {
+                    return false;
+                }
+
+                _seeds[bucketIndex] = seed;
+
+                for (int i = 0; i < bucket.Count; i++)
+                {
+                    _keys[slots[i]] = bucket[i].Key;
+                    _values[slots[i]] = entries[bucket[i].Key];
+                }
+            }
+
+            return true;
+        }
+
+        // FNV-1a over the lowercased characters
+        private static uint Hash(string name)
+        {
+            uint hash = 2166136261u;
+
+            for (int i = 0; i < name.Length; i++)
+            {
+                char c = name[i];
+
+                if (c >= 'A' && c <= 'Z')
+                {
+                    c = (char)(c + ('a' - 'A'));
+                }
+                else if (c > 0x7F)
+                {
+                    c = char.ToLowerInvariant(c);
+                }
+
+                hash ^= c;
+                hash *= 16777619u;
+            }
+
+            return hash;
+        }
+
+        // spreads the hash over the low bits, which are the ones used as an index
+        private static int Mix(uint hash)
+        {
+            hash ^= hash >> 16;
+            hash *= 0x85EBCA6Bu;
+            hash ^= hash >> 13;
+            hash *= 0xC2B2AE35u;
+            hash ^= hash >> 16;
+
+            return (int)(hash & 0x7FFFFFFF);
+        }
+
+        private int Slot(uint hash, int seed)
+        {
+            return Mix(hash ^ ((uint)seed * 0x9E3779B9u)) & _mask;
+        }
+
+        public bool TryGetValue(string name, out int value)
+        {
+            if (_additions != null && _additions.TryGetValue(name, out value))
+            {
+                return true;
+            }
+
+            uint hash = Hash(name);
+            int slot = Slot(hash, _seeds[Mix(hash) & _bucketMask]);
+            var key = _keys[slot];
+
+            if (key != null && string.Equals(key, name, StringComparison.OrdinalIgnoreCase))
+            {
+                value = _values[slot];
+                return true;
+            }
+
+            value = 0;
+            return false;
+        }
+
+        public bool ContainsKey(string name)
+        {
+            int value;
+            return TryGetValue(name, out value);
+        }
+
+        public void Add(string name, int value)
+        {
+            if (_additions == null)
+            {
+                _additions = new Dictionary<string, int>(StringComparer.OrdinalIgnoreCase);
+            }
+
+            _additions[name] = value;
+        }
+    }
+}
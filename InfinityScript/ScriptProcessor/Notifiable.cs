@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.Dynamic;
 using System.Linq;
+using System.Reflection;
 using System.Text;
 
 namespace InfinityScript
@@ -13,13 +14,29 @@ namespace InfinityScript
         {
             if (!_notifyHandlers.ContainsKey(type))
             {
-                _notifyHandlers[type] = new List<Delegate>();
+                _notifyHandlers[type] = new List<NotifyHandler>();
+
+                // the game only passes the notify types we subscribed to
+                GameInterface.Script_SubscribeNotify(type);
             }
 
-            _notifyHandlers[type].Add(handler);
+            _notifyHandlers[type].Add(new NotifyHandler()
+            {
+                handler = handler,
+                invoker = DelegateInvoker.CreateNotifyInvoker(handler)
+            });
         }
         #endregion
 
+        private sealed class NotifyHandler
+        {
+            public Delegate handler;
+            public Action<Notifiable, Parameter[]> invoker;
+
+            // looked up on the first profiled call
+            public ProfileEntry profile;
+        }
+
         private struct NotifyData
         {
             public int entity;
@@ -27,116 +44,214 @@ namespace InfinityScript
             public Parameter[] parameters;
         }
 
-        private Dictionary<string, List<Delegate>> _notifyHandlers = new Dictionary<string, List<Delegate>>();
+        private Dictionary<string, List<NotifyHandler>> _notifyHandlers = new Dictionary<string, List<NotifyHandler>>();
         private List<NotifyData> _pendingNotifys = new List<NotifyData>();
 
-        public event Action<string, Parameter[]> Notified;
+        private EventSubscribers _notified;
+
+        public event Action<string, Parameter[]> Notified
+        {
+            add
+            {
+                // this handler wants every notify type
+                GameInterface.Script_SubscribeAllNotifies();
+
+                if (_notified == null)
+                {
+                    _notified = new EventSubscribers("Notified");
+                }
+
+                _notified.Add(value);
+            }
+            remove
+            {
+                if (_notified != null)
+                {
+                    _notified.Remove(value);
+                }
+            }
+        }
+
+        // the subscribers of an event raised for a notify type, like Entity.SpawnedPlayer
+        internal virtual EventSubscribers GetEventSubscribers(string type)
+        {
+            return null;
+        }
+
+        // coroutines waiting for a notify type, the spare list takes new waiters while the current ones resume
+        private Dictionary<string, List<Coroutine>> _waiters;
+        private List<Coroutine> _spareWaiters;
 
         internal void ProcessNotifications()
         {
-            // handle notify events
-            var notifys = _pendingNotifys.ToArray();
-            _pendingNotifys.Clear();
+            // handle notify events; ones queued by the handlers wait for the next frame, like the ones left when out of time.
+            // the first one always goes, so a notifiable late in the frame still makes progress
+            int count = _pendingNotifys.Count;
+            int processed = 0;
 
-            foreach (var notify in notifys)
+            try
             {
-                if (Notified != null)
+                while (processed < count && (processed == 0 || !FrameBudget.Exhausted))
                 {
-                    Notified(notify.type, notify.parameters);
+                    ProcessNotification(_pendingNotifys[processed++]);
                 }
+            }
+            finally
+            {
+                _pendingNotifys.RemoveRange(0, processed);
+            }
+        }
 
-                if (_notifyHandlers.ContainsKey(notify.type))
+        private void ProcessNotification(NotifyData notify)
+        {
+            if (_notified != null)
+            {
+                _notified.Raise(this, notify.type, notify.parameters);
+            }
+
+            var subscribers = GetEventSubscribers(notify.type);
+
+            if (subscribers != null)
+            {
+                subscribers.Raise(this, notify.type, notify.parameters);
+            }
+
+            if (_notifyHandlers.ContainsKey(notify.type))
+            {
+                var handlers = _notifyHandlers[notify.type];
+
+                foreach (var handler in handlers)
                 {
-                    var handlers = _notifyHandlers[notify.type];
+                    if (ScriptWatchdog.IsDisabled(handler.handler))
+                    {
+                        continue;
+                    }
+
+                    var sample = ScriptProfiler.Begin();
+                    ScriptWatchdog.Enter(handler.handler, notify.type);
 
-                    foreach (var handler in handlers)
+                    try
                     {
-                        try
-                        {
-                            var parameters = handler.Method.GetParameters();
-
-                            if (parameters.Length > 0 && parameters[0].ParameterType == typeof(Entity))
-                            {
-                                var newParameters = new object[notify.parameters.Length + 1];
-                                newParameters[0] = (this is Entity) ? (Entity)this : null;
-                                Array.Copy(notify.parameters, 0, newParameters, 1, notify.parameters.Length);
-                                
-                                handler.DynamicInvoke(newParameters);
-                            }
-                            else
-                            {
-                                handler.DynamicInvoke(notify.parameters);
-                            }
-                        }
-                        catch (Exception ex)
+                        handler.invoker(this, notify.parameters);
+                    }
+                    catch (Exception ex)
+                    {
+                        if (!ScriptWatchdog.HandleAbort(ex))
                         {
-                            Log.Write(LogLevel.Error, "Exception during handling of notify event {0} on {1}: {2}", notify.type, this, (ex.InnerException != null) ? ex.InnerException.ToString() : ex.ToString());
+                            Log.Write(LogLevel.Error, "Exception during handling of notify event {0} on {1}: {2}", notify.type, this, (ex is TargetInvocationException) ? ex.InnerException.ToString() : ex.ToString());
                         }
                     }
+                    finally
+                    {
+                        ScriptWatchdog.Exit();
+                    }
+
+                    ScriptProfiler.End(ref handler.profile, handler.handler, notify.type, sample);
                 }
             }
+
+            List<Coroutine> waiters;
+
+            if (_waiters != null && _waiters.TryGetValue(notify.type, out waiters) && waiters.Count > 0)
+            {
+                _waiters[notify.type] = _spareWaiters ?? new List<Coroutine>();
+
+                for (int i = 0; i < waiters.Count; i++)
+                {
+                    waiters[i].ResumeNotify(notify.parameters);
+                }
+
+                waiters.Clear();
+                _spareWaiters = waiters;
+            }
+
+            // went away while handling this notify (like a player on disconnect), after the waiters for it got it
+            if (_timersStopped)
+            {
+                CancelWaiters();
+            }
         }
 
         #region ontimer
-        internal int _currentTime;
+        // set once an entity goes away, its timers get dropped instead of running
+        internal bool _timersStopped;
 
-        internal class ScriptTimer
+        internal ScriptTimer AddTimer(int delay, int interval, Delegate function)
         {
-            public Delegate func;
-            public int triggerTime;
-            public int interval;
+            return TimerScheduler.Add(this, function, TimerScheduler.CurrentTime + delay, interval);
         }
+        #endregion
 
-        internal List<ScriptTimer> _timers = new List<ScriptTimer>();
+        #region coroutines
+        // runs the coroutine up to its first wait; it stops when this entity goes away
+        public Coroutine StartCoroutine(IEnumerator<WaitRequest> routine)
+        {
+            var coroutine = new Coroutine(this, routine);
+            coroutine.Resume();
+
+            return coroutine;
+        }
 
-        internal void ProcessTimers()
+        public WaitRequest WaitTill(string notify)
         {
-            Function.SetEntRef(-1);
-            _currentTime = Function.Call<int>("getTime");
+            return new WaitRequest(WaitType.Notify, 0, this, notify, null);
+        }
 
-            var timers = _timers.ToArray();
+        // result gets the notify arguments once the coroutine continues
+        public WaitRequest WaitTill(string notify, NotifyResult result)
+        {
+            return new WaitRequest(WaitType.Notify, 0, this, notify, result);
+        }
 
-            foreach (var timer in timers)
+        internal void AddWaiter(string type, Coroutine coroutine)
+        {
+            if (_waiters == null)
             {
-                if (_currentTime >= timer.triggerTime)
-                {
-                    try
-                    {
-                        var parameters = timer.func.Method.GetParameters();
-                        var returnType = timer.func.Method.ReturnType;
-                        object returnValue = null;
+                _waiters = new Dictionary<string, List<Coroutine>>();
+            }
 
-                        if (parameters.Length > 0 && parameters[0].ParameterType == typeof(Entity))
-                        {
-                            returnValue = timer.func.DynamicInvoke(this);
-                        }
-                        else
-                        {
-                            returnValue = timer.func.DynamicInvoke();
-                        }
+            List<Coroutine> waiters;
 
-                        if (returnType == typeof(bool) && (bool)returnValue == false)
-                        {
-                            _timers.Remove(timer);
-                            continue;
-                        }
+            if (!_waiters.TryGetValue(type, out waiters))
+            {
+                waiters = new List<Coroutine>();
+                _waiters[type] = waiters;
 
-                        if (timer.interval != -1)
-                        {
-                            timer.triggerTime = _currentTime + timer.interval;
-                        }
-                        else
-                        {
-                            _timers.Remove(timer);
-                        }
-                    }
-                    catch (Exception ex)
-                    {
-                        Log.Write(LogLevel.Error, "Error during handling timer in script {0}: {1}", GetType().Name, (ex.InnerException != null) ? ex.InnerException.ToString() : ex.ToString());
+                GameInterface.Script_SubscribeNotify(type);
+            }
 
-                        _timers.Remove(timer);
-                    }
-                }
+            waiters.Add(coroutine);
+        }
+
+        // like GSC threads waiting on a freed entity, coroutines waiting on one that went away end instead of
+        // waiting forever
+        internal void CancelWaiters()
+        {
+            if (_waiters == null)
+            {
+                return;
+            }
+
+            var waiters = new List<Coroutine>();
+
+            foreach (var list in _waiters.Values)
+            {
+                waiters.AddRange(list);
+            }
+
+            foreach (var coroutine in waiters)
+            {
+                coroutine.Cancel();
+            }
+        }
+
+        internal void RemoveWaiter(string type, Coroutine coroutine)
+        {
+            List<Coroutine> waiters;
+
+            if (_waiters != null && _waiters.TryGetValue(type, out waiters))
+            {
+                waiters.Remove(coroutine);
             }
         }
         #endregion
@@ -144,7 +259,11 @@ namespace InfinityScript
         #region handlenotify
         internal void HandleNotify(int entity, string type, Parameter[] paras)
         {
-            if (Notified != null || _notifyHandlers.ContainsKey(type))
+            List<Coroutine> waiters;
+            EventSubscribers subscribers;
+
+            if ((_notified != null && !_notified.IsEmpty) || _notifyHandlers.ContainsKey(type) || (_waiters != null && _waiters.TryGetValue(type, out waiters) && waiters.Count > 0) ||
+                ((subscribers = GetEventSubscribers(type)) != null && !subscribers.IsEmpty))
             {
                 _pendingNotifys.Add(new NotifyData()
                 {
@@ -5,16 +5,29 @@ using System.Text;
 
 namespace InfinityScript
 {
-    public class Parameter
+    // tagged union: integers, floats and vectors are stored inline, so that they don't get boxed
+    public struct Parameter
     {
         private VariableType _type;
-        private object _value;
+        private int _intValue;
+        private Vector3 _vectorValue; // floats use X
+        private object _objectValue; // strings, entities and anything else
 
         internal object InternalValue
         {
             get
             {
-                return _value;
+                switch (_type)
+                {
+                    case VariableType.Integer:
+                        return _intValue;
+                    case VariableType.Float:
+                        return _vectorValue.X;
+                    case VariableType.Vector:
+                        return _vectorValue;
+                    default:
+                        return _objectValue;
+                }
             }
         }
 
@@ -27,40 +40,150 @@ namespace InfinityScript
         }
 
         internal Parameter(VariableType type, object value)
+            : this()
         {
             _type = type;
-            _value = value;
+
+            switch (type)
+            {
+                case VariableType.Integer:
+                    _intValue = Convert.ToInt32(value);
+                    break;
+                case VariableType.Float:
+                    _vectorValue.X = Convert.ToSingle(value);
+                    break;
+                case VariableType.Vector:
+                    _vectorValue = (Vector3)value;
+                    break;
+                default:
+                    _objectValue = value;
+                    break;
+            }
         }
 
         public static explicit operator int(Parameter p)
         {
-            return Convert.ToInt32(p._value);
+            return p.AsInt();
         }
 
         public static explicit operator float(Parameter p)
         {
-            return Convert.ToSingle(p._value);
+            return p.AsFloat();
         }
 
         public static explicit operator string(Parameter p)
         {
-            return Convert.ToString(p._value);
+            return p.AsString();
         }
 
         public static explicit operator Entity(Parameter p)
         {
-            return (Entity)p._value;
+            return (Entity)p._objectValue;
         }
 
         public T As<T>()
         {
-            return (T)Convert.ChangeType(_value, typeof(T));
+            return Converter<T>.Convert(this);
+        }
+
+        private int AsInt()
+        {
+            switch (_type)
+            {
+                case VariableType.Integer:
+                    return _intValue;
+                case VariableType.Float:
+                    return Convert.ToInt32(_vectorValue.X);
+                default:
+                    return Convert.ToInt32(_objectValue);
+            }
+        }
+
+        private float AsFloat()
+        {
+            switch (_type)
+            {
+                case VariableType.Integer:
+                    return _intValue;
+                case VariableType.Float:
+                    return _vectorValue.X;
+                default:
+                    return Convert.ToSingle(_objectValue);
+            }
+        }
+
+        private string AsString()
+        {
+            switch (_type)
+            {
+                case VariableType.Integer:
+                    return Convert.ToString(_intValue);
+                case VariableType.Float:
+                    return Convert.ToString(_vectorValue.X);
+                case VariableType.Vector:
+                    return _vectorValue.ToString();
+                default:
+                    return Convert.ToString(_objectValue);
+            }
+        }
+
+        private Vector3 AsVector()
+        {
+            if (_type == VariableType.Vector)
+            {
+                return _vectorValue;
+            }
+
+            return (Vector3)Convert.ChangeType(InternalValue, typeof(Vector3));
+        }
+
+        // typed conversions for As<T>, picked once per type
+        private static class Converter<T>
+        {
+            public static readonly Func<Parameter, T> Convert = CreateConverter();
+
+            private static Func<Parameter, T> CreateConverter()
+            {
+                object converter;
+
+                if (typeof(T) == typeof(int))
+                {
+                    converter = new Func<Parameter, int>(p => p.AsInt());
+                }
+                else if (typeof(T) == typeof(float))
+                {
+                    converter = new Func<Parameter, float>(p => p.AsFloat());
+                }
+                else if (typeof(T) == typeof(bool))
+                {
+                    converter = new Func<Parameter, bool>(p => (p._type == VariableType.Integer) ? (p._intValue != 0) : System.Convert.ToBoolean(p.InternalValue));
+                }
+                else if (typeof(T) == typeof(string))
+                {
+                    converter = new Func<Parameter, string>(p => p.AsString());
+                }
+                else if (typeof(T) == typeof(Vector3))
+                {
+                    converter = new Func<Parameter, Vector3>(p => p.AsVector());
+                }
+                else if (typeof(T) == typeof(Entity))
+                {
+                    converter = new Func<Parameter, Entity>(p => (Entity)p._objectValue);
+                }
+                else
+                {
+                    converter = new Func<Parameter, T>(p => (T)System.Convert.ChangeType(p.InternalValue, typeof(T)));
+                }
+
+                return (Func<Parameter, T>)converter;
+            }
         }
 
         public Parameter(string v)
+            : this()
         {
             _type = VariableType.String;
-            _value = v;
+            _objectValue = v;
         }
 
         public static implicit operator Parameter(string v)
@@ -69,9 +192,10 @@ namespace InfinityScript
         }
 
         public Parameter(int v)
+            : this()
         {
             _type = VariableType.Integer;
-            _value = v;
+            _intValue = v;
         }
 
         public static implicit operator Parameter(int v)
@@ -80,9 +204,10 @@ namespace InfinityScript
         }
 
         public Parameter(float v)
+            : this()
         {
             _type = VariableType.Float;
-            _value = v;
+            _vectorValue.X = v;
         }
 
         public static implicit operator Parameter(float v)
@@ -91,9 +216,10 @@ namespace InfinityScript
         }
 
         public Parameter(Vector3 v)
+            : this()
         {
             _type = VariableType.Vector;
-            _value = v;
+            _vectorValue = v;
         }
 
         public static implicit operator Parameter(Vector3 v)
@@ -102,9 +228,10 @@ namespace InfinityScript
         }
 
         public Parameter(Entity v)
+            : this()
         {
             _type = VariableType.Entity;
-            _value = v;
+            _objectValue = v;
         }
 
         public static implicit operator Parameter(Entity v)
@@ -118,8 +245,9 @@ namespace InfinityScript
         }
 
         public Parameter(object v)
+            : this()
         {
-            _value = v;
+            _objectValue = v;
         }
 
         internal void PushValue()
@@ -127,20 +255,19 @@ namespace InfinityScript
             switch (_type)
             {
                 case VariableType.Float:
-                    GameInterface.Script_PushFloat(Convert.ToSingle(_value));
+                    GameInterface.Script_PushFloat(_vectorValue.X);
                     break;
                 case VariableType.Integer:
-                    GameInterface.Script_PushInt(Convert.ToInt32(_value));
+                    GameInterface.Script_PushInt(_intValue);
                     break;
                 case VariableType.String:
-                    GameInterface.Script_PushString(Convert.ToString(_value));
+                    GameInterface.Script_PushString(Convert.ToString(_objectValue));
                     break;
                 case VariableType.Entity:
-                    GameInterface.Script_PushEntRef(((Entity)_value).EntRef);
+                    GameInterface.Script_PushEntRef(((Entity)_objectValue).EntRef);
                     break;
                 case VariableType.Vector:
-                    var v = (Vector3)_value;
-                    GameInterface.Script_PushVector(v.X, v.Y, v.Z);
+                    GameInterface.Script_PushVector(_vectorValue.X, _vectorValue.Y, _vectorValue.Z);
                     break;
             }
         }
@@ -149,13 +276,29 @@ namespace InfinityScript
         {
             get
             {
-                return _value == null;
+                switch (_type)
+                {
+                    case VariableType.Integer:
+                    case VariableType.Float:
+                    case VariableType.Vector:
+                        return false;
+                    default:
+                        return _objectValue == null;
+                }
             }
         }
 
         public override string ToString()
         {
-            return _value.ToString();
+            switch (_type)
+            {
+                case VariableType.Integer:
+                case VariableType.Float:
+                case VariableType.Vector:
+                    return AsString();
+                default:
+                    return _objectValue.ToString();
+            }
         }
     }
 }
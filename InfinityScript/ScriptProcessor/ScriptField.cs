@@ -0,0 +1,55 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // an entity field resolved once, to be cached by scripts accessing it often
+    public sealed class ScriptField
+    {
+        private string _name;
+        private int _identifier;
+
+        internal ScriptField(string name, int identifier)
+        {
+            _name = name;
+            _identifier = identifier;
+        }
+
+        public static ScriptField Get(string name)
+        {
+            return Entity.ResolveField(name);
+        }
+
+        public string Name
+        {
+            get
+            {
+                return _name;
+            }
+        }
+
+        // game field identifier, -1 for script-defined fields
+        public int Identifier
+        {
+            get
+            {
+                return _identifier;
+            }
+        }
+
+        public bool IsGameField
+        {
+            get
+            {
+                return _identifier != -1;
+            }
+        }
+
+        public override string ToString()
+        {
+            return _name;
+        }
+    }
+}
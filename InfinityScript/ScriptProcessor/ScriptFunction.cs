@@ -0,0 +1,66 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // a script function resolved once, to be cached by scripts calling it often
+    public sealed class ScriptFunction
+    {
+        private string _name;
+        private int _instanceIdentifier;
+        private int _globalIdentifier;
+
+        internal ScriptFunction(string name, int instanceIdentifier, int globalIdentifier)
+        {
+            _name = name;
+            _instanceIdentifier = instanceIdentifier;
+            _globalIdentifier = globalIdentifier;
+        }
+
+        public static ScriptFunction Get(string name)
+        {
+            return Function.Resolve(name);
+        }
+
+        public string Name
+        {
+            get
+            {
+                return _name;
+            }
+        }
+
+        // identifier when called on an entity, -1 if there's none
+        public int InstanceIdentifier
+        {
+            get
+            {
+                return _instanceIdentifier;
+            }
+        }
+
+        // identifier when called without an entity, -1 if there's none
+        public int GlobalIdentifier
+        {
+            get
+            {
+                return _globalIdentifier;
+            }
+        }
+
+        public bool IsValid
+        {
+            get
+            {
+                return (_instanceIdentifier != -1 || _globalIdentifier != -1);
+            }
+        }
+
+        public override string ToString()
+        {
+            return _name;
+        }
+    }
+}
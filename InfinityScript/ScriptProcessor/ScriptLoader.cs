@@ -12,6 +12,32 @@ namespace InfinityScript
     {
         private static List<string> _loadedAssemblies = new List<string>();
 
+        // script types per assembly, so that a kept script domain doesn't reflect over the assemblies again
+        private static Dictionary<Assembly, List<Type>> _scriptTypes = new Dictionary<Assembly, List<Type>>();
+        private static bool _resolveHandlerAdded;
+
+        private struct LoadedFile
+        {
+            public Assembly assembly;
+            public DateTime writeTime;
+        }
+
+        // the assembly loaded from each script file, so that a file which didn't change doesn't get loaded again
+        private static Dictionary<string, LoadedFile> _loadedFiles = new Dictionary<string, LoadedFile>(StringComparer.OrdinalIgnoreCase);
+
+        private const string ShadowDirectory = "scripts\\shadow";
+
+        // compile the scripts while the map loads, instead of method by method during the match
+        public static bool Precompile { get; set; }
+
+        // load copies of the script files from scripts\shadow, so that the files themselves can be replaced while they're loaded
+        public static bool ShadowCopy { get; set; }
+
+        static ScriptLoader()
+        {
+            Precompile = true;
+        }
+
         public static void Initialize()
         {
             LoadScripts();
@@ -19,10 +45,16 @@ namespace InfinityScript
 
         public static void LoadScripts()
         {
-            AppDomain.CurrentDomain.AssemblyResolve += new ResolveEventHandler(CurrentDomain_AssemblyResolve);
+            if (!_resolveHandlerAdded)
+            {
+                AppDomain.CurrentDomain.AssemblyResolve += new ResolveEventHandler(CurrentDomain_AssemblyResolve);
+                _resolveHandlerAdded = true;
+            }
 
             LoadAssembly(Assembly.GetExecutingAssembly());
             LoadAssemblies("scripts", "*.auto.dll");
+
+            ScriptManifest.Save();
         }
 
         public static void LoadAssemblies(string dir, string filter)
@@ -33,7 +65,7 @@ namespace InfinityScript
             {
                 try
                 {
-                    var assembly = Assembly.LoadFile(file);
+                    var assembly = LoadFile(file);
                     LoadAssembly(assembly);
                 }
                 catch (Exception ex)
@@ -43,36 +75,292 @@ namespace InfinityScript
             }
         }
 
-        private static void LoadAssembly(Assembly assembly)
+        private static Assembly LoadFile(string file)
+        {
+            file = Path.GetFullPath(file);
+
+            var writeTime = File.GetLastWriteTimeUtc(file);
+            LoadedFile loaded;
+
+            if (_loadedFiles.TryGetValue(file, out loaded) && loaded.writeTime == writeTime)
+            {
+                return loaded.assembly;
+            }
+
+            loaded.assembly = Assembly.LoadFile((ShadowCopy) ? GetShadowCopy(file, writeTime) : file);
+            loaded.writeTime = writeTime;
+
+            _loadedFiles[file] = loaded;
+
+            return loaded.assembly;
+        }
+
+        // the copies are named after the time the file was written, so a file only gets copied again once it changed
+        private static string GetShadowCopy(string file, DateTime writeTime)
+        {
+            var name = Path.GetFileNameWithoutExtension(file) + "." + writeTime.Ticks.ToString("x");
+            var copy = Path.GetFullPath(Path.Combine(ShadowDirectory, name + ".dll"));
+
+            if (!File.Exists(copy))
+            {
+                Directory.CreateDirectory(ShadowDirectory);
+                File.Copy(file, copy, true);
+
+                // keeps line numbers in exceptions
+                if (File.Exists(file + ".mdb"))
+                {
+                    File.Copy(file + ".mdb", copy + ".mdb", true);
+                }
+
+                if (File.Exists(Path.ChangeExtension(file, ".pdb")))
+                {
+                    File.Copy(Path.ChangeExtension(file, ".pdb"), Path.ChangeExtension(copy, ".pdb"), true);
+                }
+            }
+
+            return copy;
+        }
+
+        // copies left over from earlier script domains; the ones still in use can't be deleted and stay
+        internal static void CleanShadowCopies()
+        {
+            if (!Directory.Exists(ShadowDirectory))
+            {
+                return;
+            }
+
+            foreach (var file in Directory.GetFiles(ShadowDirectory))
+            {
+                try
+                {
+                    File.Delete(file);
+                }
+                catch (IOException)
+                {
+                }
+                catch (UnauthorizedAccessException)
+                {
+                }
+            }
+        }
+
+        // whether a change to file should reload it: it's loaded already, or a new script that would be loaded automatically
+        internal static bool IsScriptFile(string file)
+        {
+            file = Path.GetFullPath(file);
+
+            if (_loadedFiles.ContainsKey(file))
+            {
+                return true;
+            }
+
+            return file.EndsWith(".auto.dll", StringComparison.OrdinalIgnoreCase) &&
+                string.Equals(Path.GetDirectoryName(file), Path.GetFullPath("scripts"), StringComparison.OrdinalIgnoreCase);
+        }
+
+        // replaces the scripts of a changed file with new instances from the new file, leaving the other scripts as
+        // they are; returns the new scripts
+        internal static List<BaseScript> ReloadFile(string file)
         {
+            file = Path.GetFullPath(file);
+
+            LoadedFile old;
+            bool wasLoaded = _loadedFiles.TryGetValue(file, out old);
+
+            if (!File.Exists(file))
+            {
+                if (wasLoaded)
+                {
+                    Log.Write(LogLevel.Info, "Unloading scripts of {0}", Path.GetFileName(file));
+
+                    _loadedFiles.Remove(file);
+                    RetireAssembly(old.assembly);
+                }
+
+                return new List<BaseScript>();
+            }
+
+            var assembly = LoadFile(file);
+
+            if (wasLoaded && assembly == old.assembly)
+            {
+                // the runtime hands out the loaded assembly for the same name and version
+                if (File.GetLastWriteTimeUtc(file) != old.writeTime)
+                {
+                    Log.Write(LogLevel.Warning, "{0} changed, but kept its assembly version; use a new AssemblyVersion (like 1.0.*) for every build to reload it", Path.GetFileName(file));
+                }
+
+                return new List<BaseScript>();
+            }
+
+            if (wasLoaded)
+            {
+                RetireAssembly(old.assembly);
+            }
+
+            Log.Write(LogLevel.Info, "Reloading scripts of {0}", Path.GetFileName(file));
+
+            var scripts = LoadAssembly(assembly);
+
+            ScriptManifest.Save();
+
+            return scripts;
+        }
+
+        // the old assembly can't be unloaded from the domain, but nothing of it runs any more: its scripts go away, and
+        // the handlers, timers and coroutines it left on entities get skipped like those of a disabled script
+        private static void RetireAssembly(Assembly assembly)
+        {
+            _scriptTypes.Remove(assembly);
+
+            Type[] types;
+
             try
             {
-                Type[] types = assembly.GetTypes();
+                types = assembly.GetTypes();
+            }
+            catch (ReflectionTypeLoadException ex)
+            {
+                types = ex.Types.Where(type => type != null).ToArray();
+            }
+
+            foreach (var type in types)
+            {
+                if (type.DeclaringType == null)
+                {
+                    ScriptWatchdog.Disable(type);
+                }
+            }
+        }
+
+        private static List<BaseScript> LoadAssembly(Assembly assembly)
+        {
+            var scripts = new List<BaseScript>();
+            List<Type> scriptTypes;
+
+            if (!_scriptTypes.TryGetValue(assembly, out scriptTypes))
+            {
+                scriptTypes = ScriptManifest.GetScriptTypes(assembly);
 
-                foreach (Type type in types)
+                if (scriptTypes == null)
                 {
-                    if (type.IsPublic && !type.IsAbstract)
+                    try
                     {
-                        try
-                        {
-                            if (type.IsSubclassOf(typeof(BaseScript)))
-                            {
-                                Log.Write(LogLevel.Info, "Loading script {0} v{1}", type.Name, FileVersionInfo.GetVersionInfo(type.Assembly.Location).ProductVersion);
-
-                                BaseScript script = (BaseScript)Activator.CreateInstance(type);
-                                ScriptProcessor.AddScript(script);
-                            }
-                        }
-                        catch (Exception ex)
-                        {
-                            Log.Write(LogLevel.Error, "An error occurred during initialization of the script {0}: {1}", type.Name, ex.ToString());
-                        }
+                        scriptTypes = FindScriptTypes(assembly);
+                        ScriptManifest.Add(assembly, scriptTypes);
                     }
+                    catch (ReflectionTypeLoadException ex)
+                    {
+                        Log.Write(LogLevel.Warning, "Assembly {0} could not be loaded because of a loader exception: {1}", assembly.GetName(), ex.LoaderExceptions[0].ToString());
+                        return scripts;
+                    }
+                }
+
+                _scriptTypes[assembly] = scriptTypes;
+
+                if (Precompile)
+                {
+                    PrecompileTypes(assembly, scriptTypes);
                 }
             }
-            catch (ReflectionTypeLoadException ex)
+
+            foreach (Type type in scriptTypes)
             {
-                Log.Write(LogLevel.Warning, "Assembly {0} could not be loaded because of a loader exception: {1}", assembly.GetName(), ex.LoaderExceptions[0].ToString());
+                try
+                {
+                    Log.Write(LogLevel.Info, "Loading script {0} v{1}", type.Name, FileVersionInfo.GetVersionInfo(type.Assembly.Location).ProductVersion);
+
+                    BaseScript script = (BaseScript)Activator.CreateInstance(type);
+                    ScriptProcessor.AddScript(script);
+                    scripts.Add(script);
+                }
+                catch (Exception ex)
+                {
+                    Log.Write(LogLevel.Error, "An error occurred during initialization of the script {0}: {1}", type.Name, ex.ToString());
+                }
+            }
+
+            return scripts;
+        }
+
+        private static List<Type> FindScriptTypes(Assembly assembly)
+        {
+            var scriptTypes = new List<Type>();
+
+            foreach (Type type in assembly.GetTypes())
+            {
+                if (type.IsPublic && !type.IsAbstract && type.IsSubclassOf(typeof(BaseScript)))
+                {
+                    scriptTypes.Add(type);
+                }
+            }
+
+            return scriptTypes;
+        }
+
+        // scripts get their own methods and those of their nested closure and iterator classes compiled,
+        // InfinityScript itself all of its methods; the methods found are kept in the manifest, so a known assembly
+        // only needs its method tokens resolved
+        private static void PrecompileTypes(Assembly assembly, List<Type> scriptTypes)
+        {
+            var stopwatch = Stopwatch.StartNew();
+            int numMethods = 0;
+
+            try
+            {
+                var tokens = ScriptManifest.GetMethodTokens(assembly);
+
+                if (tokens == null)
+                {
+                    var types = (assembly == Assembly.GetExecutingAssembly()) ? assembly.GetTypes() : scriptTypes.ToArray();
+                    var methods = new List<int>();
+
+                    FindPrecompiledMethods(types, methods);
+
+                    tokens = methods.ToArray();
+                    ScriptManifest.SetMethodTokens(assembly, tokens);
+                }
+
+                var module = assembly.ManifestModule;
+
+                foreach (var token in tokens)
+                {
+                    GameInterface.CompileMethod(module.ResolveMethod(token).MethodHandle.Value);
+                    numMethods++;
+                }
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Warning, "Could not precompile {0}: {1}", assembly.GetName().Name, ex.Message);
+            }
+
+            Log.Write(LogLevel.Debug, "Precompiled {0} methods of {1} in {2} msec.", numMethods, assembly.GetName().Name, stopwatch.ElapsedMilliseconds);
+        }
+
+        private static void FindPrecompiledMethods(Type[] types, List<int> methods)
+        {
+            const BindingFlags flags = BindingFlags.DeclaredOnly | BindingFlags.Instance | BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic;
+
+            foreach (var type in types)
+            {
+                // generic code gets compiled per instantiation, which isn't known yet
+                if (type.ContainsGenericParameters)
+                {
+                    continue;
+                }
+
+                foreach (var method in type.GetMethods(flags).Cast<MethodBase>().Concat(type.GetConstructors(flags)))
+                {
+                    if (method.IsAbstract || method.ContainsGenericParameters || (method.Attributes & MethodAttributes.PinvokeImpl) != 0 ||
+                        (method.GetMethodImplementationFlags() & (MethodImplAttributes.InternalCall | MethodImplAttributes.Runtime)) != 0)
+                    {
+                        continue;
+                    }
+
+                    methods.Add(method.MetadataToken);
+                }
+
+                FindPrecompiledMethods(type.GetNestedTypes(BindingFlags.Public | BindingFlags.NonPublic), methods);
             }
         }
 
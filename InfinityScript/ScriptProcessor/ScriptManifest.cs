@@ -0,0 +1,207 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+
+namespace InfinityScript
+{
+    // the script types found in each script assembly, and the methods to precompile of it, kept on disk so that loading
+    // a known assembly doesn't need to reflect over all of its types; assemblies are keyed by their module version ID,
+    // which changes on every build
+    internal static class ScriptManifest
+    {
+        private const string FileName = "scripts\\scripttypes.cache";
+
+        private struct Entry
+        {
+            // the file name the assembly was built as, like test.auto.dll
+            public string module;
+            public string[] typeNames;
+
+            // metadata tokens of the methods to precompile, null if not known yet
+            public int[] methodTokens;
+        }
+
+        private static Dictionary<Guid, Entry> _entries;
+        private static bool _changed;
+
+        // the entries of the assemblies loaded in this domain
+        private static HashSet<Guid> _used = new HashSet<Guid>();
+
+        // null if the assembly isn't in the manifest, or the manifest doesn't match it
+        public static List<Type> GetScriptTypes(Assembly assembly)
+        {
+            Load();
+
+            Entry entry;
+
+            if (!_entries.TryGetValue(assembly.ManifestModule.ModuleVersionId, out entry))
+            {
+                return null;
+            }
+
+            var types = new List<Type>(entry.typeNames.Length);
+
+            foreach (var typeName in entry.typeNames)
+            {
+                var type = assembly.GetType(typeName, false);
+
+                if (type == null || !type.IsSubclassOf(typeof(BaseScript)))
+                {
+                    return null;
+                }
+
+                types.Add(type);
+            }
+
+            _used.Add(assembly.ManifestModule.ModuleVersionId);
+
+            return types;
+        }
+
+        public static void Add(Assembly assembly, List<Type> types)
+        {
+            Load();
+
+            var id = assembly.ManifestModule.ModuleVersionId;
+
+            _entries[id] = new Entry() { module = assembly.ManifestModule.ScopeName, typeNames = types.Select(type => type.FullName).ToArray() };
+            _used.Add(id);
+            _changed = true;
+        }
+
+        // null if the assembly isn't in the manifest, or didn't get precompiled yet
+        public static int[] GetMethodTokens(Assembly assembly)
+        {
+            Load();
+
+            Entry entry;
+
+            if (!_entries.TryGetValue(assembly.ManifestModule.ModuleVersionId, out entry))
+            {
+                return null;
+            }
+
+            return entry.methodTokens;
+        }
+
+        // for an assembly added to the manifest before
+        public static void SetMethodTokens(Assembly assembly, int[] tokens)
+        {
+            Load();
+
+            var id = assembly.ManifestModule.ModuleVersionId;
+            Entry entry;
+
+            if (!_entries.TryGetValue(id, out entry))
+            {
+                return;
+            }
+
+            entry.methodTokens = tokens;
+            _entries[id] = entry;
+            _changed = true;
+        }
+
+        public static void Save()
+        {
+            if (_entries == null)
+            {
+                return;
+            }
+
+            RemoveStale();
+
+            if (!_changed)
+            {
+                return;
+            }
+
+            try
+            {
+                File.WriteAllLines(FileName, _entries.Select(entry => FormatEntry(entry.Key, entry.Value)).ToArray());
+                _changed = false;
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Warning, "Could not write the script manifest {0}: {1}", FileName, ex.Message);
+            }
+        }
+
+        // id, module and types, then the method tokens if known, separated by tabs
+        private static string FormatEntry(Guid id, Entry entry)
+        {
+            var line = id.ToString("N") + "\t" + entry.module + "\t" + string.Join(",", entry.typeNames);
+
+            if (entry.methodTokens != null)
+            {
+                line += "\t" + string.Join(",", entry.methodTokens.Select(token => token.ToString("x8")).ToArray());
+            }
+
+            return line;
+        }
+
+        // drops the entries of older builds of the loaded assemblies, and of script files that are gone; the others
+        // may still be loaded later on, by a loadScript
+        private static void RemoveStale()
+        {
+            var usedModules = new HashSet<string>(_used.Where(id => _entries.ContainsKey(id)).Select(id => _entries[id].module), StringComparer.OrdinalIgnoreCase);
+
+            var stale = _entries.Where(entry => !_used.Contains(entry.Key) &&
+                (usedModules.Contains(entry.Value.module) || !File.Exists(Path.Combine("scripts", entry.Value.module)))).Select(entry => entry.Key).ToList();
+
+            foreach (var id in stale)
+            {
+                _entries.Remove(id);
+                _changed = true;
+            }
+        }
+
+        private static void Load()
+        {
+            if (_entries != null)
+            {
+                return;
+            }
+
+            _entries = new Dictionary<Guid, Entry>();
+
+            if (!File.Exists(FileName))
+            {
+                return;
+            }
+
+            try
+            {
+                foreach (var line in File.ReadAllLines(FileName))
+                {
+                    var parts = line.Split('\t');
+
+                    if (parts.Length != 3 && parts.Length != 4)
+                    {
+                        _changed = true;
+                        continue;
+                    }
+
+                    var entry = new Entry() { module = parts[1], typeNames = parts[2].Split(new[] { ',' }, StringSplitOptions.RemoveEmptyEntries) };
+
+                    if (parts.Length == 4)
+                    {
+                        entry.methodTokens = parts[3].Split(new[] { ',' }, StringSplitOptions.RemoveEmptyEntries).Select(token => int.Parse(token, NumberStyles.HexNumber)).ToArray();
+                    }
+
+                    _entries[new Guid(parts[0])] = entry;
+                }
+            }
+            catch (Exception ex)
+            {
+                // it gets written again from the assemblies themselves
+                Log.Write(LogLevel.Warning, "Could not read the script manifest {0}: {1}", FileName, ex.Message);
+                _entries.Clear();
+            }
+        }
+    }
+}
@@ -7,727 +7,800 @@ namespace InfinityScript
 {
     static class ScriptNames
     {
+        private struct FunctionName
+        {
+            public string Name;
+            public int ID;
+            public bool IsGlobal;
+        }
+
+        private static FunctionName Method(string name, int id)
+        {
+            return new FunctionName() { Name = name, ID = id, IsGlobal = false };
+        }
+
+        private static FunctionName Global(string name, int id)
+        {
+            return new FunctionName() { Name = name, ID = id, IsGlobal = true };
+        }
+
         public static void Initialize()
+        {
+            int numGlobals = 0;
+
+            foreach (var function in _functionNames)
+            {
+                if (function.IsGlobal)
+                {
+                    numGlobals++;
+                }
+            }
+
+            var methods = new NameEntry[_functionNames.Length - numGlobals];
+            var globals = new NameEntry[numGlobals];
+            int methodIndex = 0;
+            int globalIndex = 0;
+
+            foreach (var function in _functionNames)
+            {
+                if (function.IsGlobal)
+                {
+                    globals[globalIndex++] = new NameEntry(function.Name, function.ID);
+                }
+                else
+                {
+                    methods[methodIndex++] = new NameEntry(function.Name, function.ID);
+                }
+            }
+
+            Function.SetMappings(new NameTable(methods, MethodTableSize, _methodTableSeeds), new NameTable(globals, GlobalTableSize, _globalTableSeeds));
+        }
+
+        // frozen perfect hash parameters for the tables below (NameTable.Size and NameTable.Seeds); after a change
+        // in the names they may not fit anymore, the tables then get built at startup instead, which is slower
+        private const int MethodTableSize = 1024;
+        private static readonly int[] _methodTableSeeds = new[]
+        {
+            3, 2, 2, 4, 1, 1, 1, 1, 0, 0, 3, 2, 2, 1, 1, 1, 3, 3, 2, 1, 1, 1, 1, 5,
+            1, 1, 2, 1, 4, 1, 2, 1, 2, 2, 0, 3, 2, 1, 1, 2, 2, 7, 11, 2, 1, 1, 3, 3,
+            3, 4, 1, 2, 1, 2, 3, 1, 0, 2, 1, 1, 1, 3, 1, 1, 6, 4, 6, 1, 0, 2, 0, 1,
+            1, 5, 1, 2, 1, 2, 3, 2, 1, 3, 2, 2, 1, 2, 3, 1, 2, 3, 3, 1, 2, 3, 1, 3,
+            1, 4, 5, 2, 7, 1, 2, 2, 2, 3, 1, 1, 2, 2, 1, 2, 2, 1, 7, 1, 5, 11, 3, 1,
+            3, 3, 1, 1, 2, 1, 5, 1
+        };
+
+        private const int GlobalTableSize = 1024;
+        private static readonly int[] _globalTableSeeds = new[]
+        {
+            1, 3, 1, 1, 4, 2, 2, 1, 2, 2, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 2, 1, 1, 2,
+            0, 0, 1, 1, 3, 1, 1, 0, 1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 4, 1,
+            1, 2, 1, 1, 4, 1, 0, 1, 0, 2, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 4, 2,
+            4, 0, 1, 3, 1, 2, 3, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1, 0, 2, 2, 1, 1, 1, 2,
+            5, 1, 0, 0, 0, 1, 1, 1, 1, 2, 0, 1, 1, 0, 1, 1, 2, 4, 1, 2, 4, 2, 1, 2,
+            1, 4, 3, 1, 3, 4, 2, 3
+        };
+
+        private static readonly FunctionName[] _functionNames = new FunctionName[]
         {
             // playercmd #1
-            Function.AddMapping("getviewmodel", 33457);
-            Function.AddMapping("fragbuttonpressed", 33458);
-            Function.AddMapping("secondaryoffhandbuttonpressed", 33459);
-            Function.AddMapping("getcurrentweaponclipammo", 33460);
-            Function.AddMapping("setvelocity", 33461);
-            Function.AddMapping("getplayerviewheight", 33462);
-            Function.AddMapping("unknown", 33545);
-            Function.AddMapping("getnormalizedmovement", 33463);
-            Function.AddMapping("getnormalizedcameramovement", 33486);
-            Function.AddMapping("giveweapon", 33487);
-            Function.AddMapping("takeweapon", 33488);
-            Function.AddMapping("takeallweapons", 33489);
-            Function.AddMapping("getcurrentweapon", 33490);
-            Function.AddMapping("getcurrentprimaryweapon", 33491);
-            Function.AddMapping("getcurrentoffhand", 33492);
-            Function.AddMapping("hasweapon", 33493);
-            Function.AddMapping("switchtoweapon", 33494);
-            Function.AddMapping("switchtoweaponimmediate", 33495);
-            Function.AddMapping("switchtooffhand", 33496);
-            Function.AddMapping("givestartammo", 33522);
-            Function.AddMapping("givemaxammo", 33523);
-            Function.AddMapping("getfractionstartammo", 33524);
-            Function.AddMapping("getfractionmaxammo", 33525);
-            Function.AddMapping("isdualwielding", 33526);
-            Function.AddMapping("isreloading", 33527);
-            Function.AddMapping("isswitchingweapon", 33528);
-            Function.AddMapping("setorigin", 33529);
-            Function.AddMapping("getvelocity", 33530);
-            Function.AddMapping("setplayerangles", 33531);
-            Function.AddMapping("getplayerangles", 33532);
-            Function.AddMapping("usebuttonpressed", 33533);
-            Function.AddMapping("attackbuttonpressed", 33534);
-            Function.AddMapping("adsbuttonpressed", 33535);
-            Function.AddMapping("meleebuttonpressed", 33536);
-            Function.AddMapping("playerads", 33537);
-            Function.AddMapping("isonground", 33538);
-            Function.AddMapping("isusingturret", 33539);
-            Function.AddMapping("setviewmodel", 33540);
-            Function.AddMapping("setoffhandprimaryclass", 33541);
-            Function.AddMapping("getoffhandprimaryclass", 33542);
-            Function.AddMapping("setoffhandsecondaryclass", 33497);
-            Function.AddMapping("getoffhandsecondaryclass", 33498);
-            Function.AddMapping("beginlocationselection", 33499);
-            Function.AddMapping("endlocationselection", 33500);
-            Function.AddMapping("disableweapons", 33501);
-            Function.AddMapping("enableweapons", 33502);
-            Function.AddMapping("disableoffhandweapons", 33503);
-            Function.AddMapping("enableoffhandweapons", 33504);
-            Function.AddMapping("disableweaponswitch", 33505);
-            Function.AddMapping("enableweaponswitch", 33506);
-            Function.AddMapping("openpopupmenu", 33507);
-            Function.AddMapping("openpopupmenunomouse", 33508);
-            Function.AddMapping("closepopupmenu", 33509);
-            Function.AddMapping("openmenu", 33510);
-            Function.AddMapping("closemenu", 33511);
-            Function.AddMapping("freezecontrols", 33513);
-            Function.AddMapping("disableusability", 33514);
-            Function.AddMapping("enableusability", 33515);
-            Function.AddMapping("setwhizbyspreads", 33516);
-            Function.AddMapping("setwhizbyradii", 33517);
-            Function.AddMapping("setreverb", 33518);
-            Function.AddMapping("deactivatereverb", 33519);
-            Function.AddMapping("setvolmod", 33520);
-            Function.AddMapping("setchannelvolume", 33521);
-            Function.AddMapping("setchannelvolumes", 33464);
-            Function.AddMapping("deactivatechannelvolumes", 33465);
-            Function.AddMapping("playlocalsound", 33466);
-            Function.AddMapping("stoplocalsound", 33467);
-            Function.AddMapping("setweaponammoclip", 33468);
-            Function.AddMapping("setweaponammostock", 33469);
-            Function.AddMapping("getweaponammoclip", 33470);
-            Function.AddMapping("getweaponammostock", 33471);
-            Function.AddMapping("anyammoforweaponmodes", 33472);
-            Function.AddMapping("setclientdvar", 33473);
-            Function.AddMapping("setclientdvars", 33474);
-            Function.AddMapping("allowads", 33475);
-            Function.AddMapping("allowjump", 33476);
-            Function.AddMapping("allowsprint", 33477);
-            Function.AddMapping("setspreadoverride", 33478);
-            Function.AddMapping("resetspreadoverride", 33479);
-            Function.AddMapping("setaimspreadmovementscale", 33480);
-            Function.AddMapping("setactionslot", 33481);
-            Function.AddMapping("setviewkickscale", 33482);
-            Function.AddMapping("getviewkickscale", 33483);
-            Function.AddMapping("getweaponslistall", 33484);
-            Function.AddMapping("getweaponslistprimaries", 33485);
-            Function.AddMapping("getweaponslistoffhands", 33430);
-            Function.AddMapping("getweaponslistitems", 33431);
-            Function.AddMapping("getweaponslistexclusives", 33432);
-            Function.AddMapping("getweaponslist", 33433);
-            Function.AddMapping("canplayerplacesentry", 33434);
-            Function.AddMapping("canplayerplacetank", 33435);
-            Function.AddMapping("visionsetnakedforplayer", 33436);
-            Function.AddMapping("visionsetnightforplayer", 33437);
-            Function.AddMapping("visionsetmissilecamforplayer", 33438);
-            Function.AddMapping("visionsetthermalforplayer", 33439);
-            Function.AddMapping("visionsetpainforplayer", 33440);
-            Function.AddMapping("setblurforplayer", 33441);
-            Function.AddMapping("getplayerweaponmodel", 33442);
-            Function.AddMapping("getplayerknifemodel", 33443);
-            Function.AddMapping("updateplayermodelwithweapons", 33444);
-            Function.AddMapping("notifyonplayercommand", 33445);
-            Function.AddMapping("canmantle", 33446);
-            Function.AddMapping("forcemantle", 33447);
-            Function.AddMapping("ismantling", 33448);
-            Function.AddMapping("playfx", 33449);
-            Function.AddMapping("recoilscaleon", 33450);
-            Function.AddMapping("recoilscaleoff", 33451);
-            Function.AddMapping("weaponlockstart", 33452);
-            Function.AddMapping("weaponlockfinalize", 33453);
-            Function.AddMapping("weaponlockfree", 33454);
-            Function.AddMapping("weaponlocktargettooclose", 33455);
-            Function.AddMapping("weaponlocknoclearance", 33390);
-            Function.AddMapping("visionsyncwithplayer", 33391);
-            Function.AddMapping("showhudsplash", 33392);
-            Function.AddMapping("setperk", 33393);
-            Function.AddMapping("hasperk", 33394);
-            Function.AddMapping("clearperks", 33395);
-            Function.AddMapping("unsetperk", 33396);
-            Function.AddMapping("noclip", 33397);
-            Function.AddMapping("ufo", 33398);
+            Method("getviewmodel", 33457),
+            Method("fragbuttonpressed", 33458),
+            Method("secondaryoffhandbuttonpressed", 33459),
+            Method("getcurrentweaponclipammo", 33460),
+            Method("setvelocity", 33461),
+            Method("getplayerviewheight", 33462),
+            Method("unknown", 33545),
+            Method("getnormalizedmovement", 33463),
+            Method("getnormalizedcameramovement", 33486),
+            Method("giveweapon", 33487),
+            Method("takeweapon", 33488),
+            Method("takeallweapons", 33489),
+            Method("getcurrentweapon", 33490),
+            Method("getcurrentprimaryweapon", 33491),
+            Method("getcurrentoffhand", 33492),
+            Method("hasweapon", 33493),
+            Method("switchtoweapon", 33494),
+            Method("switchtoweaponimmediate", 33495),
+            Method("switchtooffhand", 33496),
+            Method("givestartammo", 33522),
+            Method("givemaxammo", 33523),
+            Method("getfractionstartammo", 33524),
+            Method("getfractionmaxammo", 33525),
+            Method("isdualwielding", 33526),
+            Method("isreloading", 33527),
+            Method("isswitchingweapon", 33528),
+            Method("setorigin", 33529),
+            Method("getvelocity", 33530),
+            Method("setplayerangles", 33531),
+            Method("getplayerangles", 33532),
+            Method("usebuttonpressed", 33533),
+            Method("attackbuttonpressed", 33534),
+            Method("adsbuttonpressed", 33535),
+            Method("meleebuttonpressed", 33536),
+            Method("playerads", 33537),
+            Method("isonground", 33538),
+            Method("isusingturret", 33539),
+            Method("setviewmodel", 33540),
+            Method("setoffhandprimaryclass", 33541),
+            Method("getoffhandprimaryclass", 33542),
+            Method("setoffhandsecondaryclass", 33497),
+            Method("getoffhandsecondaryclass", 33498),
+            Method("beginlocationselection", 33499),
+            Method("endlocationselection", 33500),
+            Method("disableweapons", 33501),
+            Method("enableweapons", 33502),
+            Method("disableoffhandweapons", 33503),
+            Method("enableoffhandweapons", 33504),
+            Method("disableweaponswitch", 33505),
+            Method("enableweaponswitch", 33506),
+            Method("openpopupmenu", 33507),
+            Method("openpopupmenunomouse", 33508),
+            Method("closepopupmenu", 33509),
+            Method("openmenu", 33510),
+            Method("closemenu", 33511),
+            Method("freezecontrols", 33513),
+            Method("disableusability", 33514),
+            Method("enableusability", 33515),
+            Method("setwhizbyspreads", 33516),
+            Method("setwhizbyradii", 33517),
+            Method("setreverb", 33518),
+            Method("deactivatereverb", 33519),
+            Method("setvolmod", 33520),
+            Method("setchannelvolume", 33521),
+            Method("setchannelvolumes", 33464),
+            Method("deactivatechannelvolumes", 33465),
+            Method("playlocalsound", 33466),
+            Method("stoplocalsound", 33467),
+            Method("setweaponammoclip", 33468),
+            Method("setweaponammostock", 33469),
+            Method("getweaponammoclip", 33470),
+            Method("getweaponammostock", 33471),
+            Method("anyammoforweaponmodes", 33472),
+            Method("setclientdvar", 33473),
+            Method("setclientdvars", 33474),
+            Method("allowads", 33475),
+            Method("allowjump", 33476),
+            Method("allowsprint", 33477),
+            Method("setspreadoverride", 33478),
+            Method("resetspreadoverride", 33479),
+            Method("setaimspreadmovementscale", 33480),
+            Method("setactionslot", 33481),
+            Method("setviewkickscale", 33482),
+            Method("getviewkickscale", 33483),
+            Method("getweaponslistall", 33484),
+            Method("getweaponslistprimaries", 33485),
+            Method("getweaponslistoffhands", 33430),
+            Method("getweaponslistitems", 33431),
+            Method("getweaponslistexclusives", 33432),
+            Method("getweaponslist", 33433),
+            Method("canplayerplacesentry", 33434),
+            Method("canplayerplacetank", 33435),
+            Method("visionsetnakedforplayer", 33436),
+            Method("visionsetnightforplayer", 33437),
+            Method("visionsetmissilecamforplayer", 33438),
+            Method("visionsetthermalforplayer", 33439),
+            Method("visionsetpainforplayer", 33440),
+            Method("setblurforplayer", 33441),
+            Method("getplayerweaponmodel", 33442),
+            Method("getplayerknifemodel", 33443),
+            Method("updateplayermodelwithweapons", 33444),
+            Method("notifyonplayercommand", 33445),
+            Method("canmantle", 33446),
+            Method("forcemantle", 33447),
+            Method("ismantling", 33448),
+            Method("playfx", 33449),
+            Method("recoilscaleon", 33450),
+            Method("recoilscaleoff", 33451),
+            Method("weaponlockstart", 33452),
+            Method("weaponlockfinalize", 33453),
+            Method("weaponlockfree", 33454),
+            Method("weaponlocktargettooclose", 33455),
+            Method("weaponlocknoclearance", 33390),
+            Method("visionsyncwithplayer", 33391),
+            Method("showhudsplash", 33392),
+            Method("setperk", 33393),
+            Method("hasperk", 33394),
+            Method("clearperks", 33395),
+            Method("unsetperk", 33396),
+            Method("noclip", 33397),
+            Method("ufo", 33398),
 
             // playercmd #2
-            Function.AddMapping("pingplayer", 33308);
-            Function.AddMapping("buttonpressed", 33309);
-            Function.AddMapping("sayall", 33310);
-            Function.AddMapping("sayteam", 33311);
-            Function.AddMapping("showscoreboard", 33312);
-            Function.AddMapping("setspawnweapon", 33313);
-            Function.AddMapping("dropitem", 33314);
-            Function.AddMapping("dropscavengerbag", 33315);
-            Function.AddMapping("finishplayerdamage", 33340);
-            Function.AddMapping("suicide", 33341);
-            Function.AddMapping("closeingamemenu", 33342);
-            Function.AddMapping("iprintln", 33343);
-            Function.AddMapping("iprintlnbold", 33344);
-            Function.AddMapping("spawn", 33345);
-            Function.AddMapping("setentertime", 33346);
-            Function.AddMapping("cloneplayer", 33347);
-            Function.AddMapping("istalking", 33348);
-            Function.AddMapping("allowspectateteam", 33349);
-            Function.AddMapping("getguid", 33350);
-            Function.AddMapping("getxuid", 33382);
-            Function.AddMapping("ishost", 33383);
-            Function.AddMapping("getspectatingplayer", 33384);
-            Function.AddMapping("predictstreampos", 33385);
-            Function.AddMapping("updatescores", 33386);
-            Function.AddMapping("updatedmscores", 33387);
-            Function.AddMapping("setrank", 33388);
-            Function.AddMapping("setcardtitle", 33389);
-            Function.AddMapping("setcardicon", 33420);
-            Function.AddMapping("setcardnameplate", 33421);
-            Function.AddMapping("setcarddisplayslot", 33422);
-            Function.AddMapping("regweaponforfxremoval", 33423);
-            Function.AddMapping("laststandrevive", 33424);
-            Function.AddMapping("setspectatedefaults", 33425);
-            Function.AddMapping("getthirdpersoncrosshairoffset", 33426);
-            Function.AddMapping("disableweaponpickup", 33427);
-            Function.AddMapping("enableweaponpickup", 33428);
+            Method("pingplayer", 33308),
+            Method("buttonpressed", 33309),
+            Method("sayall", 33310),
+            Method("sayteam", 33311),
+            Method("showscoreboard", 33312),
+            Method("setspawnweapon", 33313),
+            Method("dropitem", 33314),
+            Method("dropscavengerbag", 33315),
+            Method("finishplayerdamage", 33340),
+            Method("suicide", 33341),
+            Method("closeingamemenu", 33342),
+            Method("iprintln", 33343),
+            Method("iprintlnbold", 33344),
+            Method("spawn", 33345),
+            Method("setentertime", 33346),
+            Method("cloneplayer", 33347),
+            Method("istalking", 33348),
+            Method("allowspectateteam", 33349),
+            Method("getguid", 33350),
+            Method("getxuid", 33382),
+            Method("ishost", 33383),
+            Method("getspectatingplayer", 33384),
+            Method("predictstreampos", 33385),
+            Method("updatescores", 33386),
+            Method("updatedmscores", 33387),
+            Method("setrank", 33388),
+            Method("setcardtitle", 33389),
+            Method("setcardicon", 33420),
+            Method("setcardnameplate", 33421),
+            Method("setcarddisplayslot", 33422),
+            Method("regweaponforfxremoval", 33423),
+            Method("laststandrevive", 33424),
+            Method("setspectatedefaults", 33425),
+            Method("getthirdpersoncrosshairoffset", 33426),
+            Method("disableweaponpickup", 33427),
+            Method("enableweaponpickup", 33428),
 
             // HECmd
-            Function.AddMapping("settext", 32950);
-            Function.AddMapping("clearalltextafterhudelem", 32951);
-            Function.AddMapping("setshader", 32952);
-            Function.AddMapping("settargetent", 32953);
-            Function.AddMapping("cleartargetent", 32954);
-            Function.AddMapping("settimer", 32955);
-            Function.AddMapping("settimerup", 32956);
-            Function.AddMapping("settimerstatic", 32957);
-            Function.AddMapping("settenthstimer", 32958);
-            Function.AddMapping("settenthstimerup", 32959);
-            Function.AddMapping("settenthstimerstatic", 32960);
-            Function.AddMapping("setclock", 32961);
-            Function.AddMapping("setclockup", 32962);
-            Function.AddMapping("setvalue", 32963);
-            Function.AddMapping("setwaypoint", 32964);
-            Function.AddMapping("rotatingicon", 32965);
-            Function.AddMapping("secondaryarrow", 32891);
-            Function.AddMapping("setwaypointiconoffscreenonly", 32892);
-            Function.AddMapping("fadeovertime", 32893);
-            Function.AddMapping("scaleovertime", 32894);
-            Function.AddMapping("moveovertime", 32895);
-            Function.AddMapping("reset", 32896);
-            Function.AddMapping("destroy", 32897);
-            Function.AddMapping("setpulsefx", 32898);
-            Function.AddMapping("setplayernamestring", 32899);
-            Function.AddMapping("fadeovertime2", 33547);
-            Function.AddMapping("scaleovertime2", 33548);
-            Function.AddMapping("changefontscaleovertime", 32900);
+            Method("settext", 32950),
+            Method("clearalltextafterhudelem", 32951),
+            Method("setshader", 32952),
+            Method("settargetent", 32953),
+            Method("cleartargetent", 32954),
+            Method("settimer", 32955),
+            Method("settimerup", 32956),
+            Method("settimerstatic", 32957),
+            Method("settenthstimer", 32958),
+            Method("settenthstimerup", 32959),
+            Method("settenthstimerstatic", 32960),
+            Method("setclock", 32961),
+            Method("setclockup", 32962),
+            Method("setvalue", 32963),
+            Method("setwaypoint", 32964),
+            Method("rotatingicon", 32965),
+            Method("secondaryarrow", 32891),
+            Method("setwaypointiconoffscreenonly", 32892),
+            Method("fadeovertime", 32893),
+            Method("scaleovertime", 32894),
+            Method("moveovertime", 32895),
+            Method("reset", 32896),
+            Method("destroy", 32897),
+            Method("setpulsefx", 32898),
+            Method("setplayernamestring", 32899),
+            Method("fadeovertime2", 33547),
+            Method("scaleovertime2", 33548),
+            Method("changefontscaleovertime", 32900),
 
             // ScrCmd
-            Function.AddMapping("attach", 32791);
-            Function.AddMapping("attachshieldmodel", 32792);
-            Function.AddMapping("detach", 32804);
-            Function.AddMapping("detachshieldmodel", 32805);
-            Function.AddMapping("moveshieldmodel", 32806);
-            Function.AddMapping("detachall", 32807);
-            Function.AddMapping("getattachsize", 32808);
-            Function.AddMapping("getattachmodelname", 32809);
-            Function.AddMapping("getattachtagname", 32810);
-            Function.AddMapping("getattachignorecollision", 32835);
-            Function.AddMapping("hidepart", 32836);
-            Function.AddMapping("allinstances", 32837);
-            Function.AddMapping("hideallparts", 32838);
-            Function.AddMapping("showpart", 32839);
-            Function.AddMapping("showallparts", 32840);
-            Function.AddMapping("linkto", 32841);
-            Function.AddMapping("linktoblendtotag", 32842);
-            Function.AddMapping("unlink", 32843);
-            Function.AddMapping("islinked", 32867);
-            Function.AddMapping("enablelinkto", 32868);
-            Function.AddMapping("playerlinkto", 32885);
-            Function.AddMapping("playerlinktodelta", 32886);
-            Function.AddMapping("playerlinkweaponviewtodelta", 32887);
-            Function.AddMapping("playerlinktoabsolute", 32888);
-            Function.AddMapping("playerlinktoblend", 32889);
-            Function.AddMapping("playerlinkedoffsetenable", 32890);
-            Function.AddMapping("playerlinkedoffsetdisable", 32916);
-            Function.AddMapping("playerlinkedsetviewznear", 32917);
-            Function.AddMapping("playerlinkedsetusebaseangleforviewclamp", 32918);
-            Function.AddMapping("lerpviewangleclamp", 32919);
-            Function.AddMapping("setviewangleresistance", 32920);
-            Function.AddMapping("geteye", 32921);
-            Function.AddMapping("istouching", 32922);
-            Function.AddMapping("stoploopsound", 32923);
-            Function.AddMapping("stopsounds", 32924);
-            Function.AddMapping("playrumbleonentity", 32925);
-            Function.AddMapping("playrumblelooponentity", 32926);
-            Function.AddMapping("stoprumble", 32927);
-            Function.AddMapping("delete", 32928);
-            Function.AddMapping("setmodel", 32929);
-            Function.AddMapping("laseron", 32930);
-            Function.AddMapping("laseroff", 32931);
-            Function.AddMapping("laseraltviewon", 32932);
-            Function.AddMapping("laseraltviewoff", 32933);
-            Function.AddMapping("thermalvisionon", 32934);
-            Function.AddMapping("thermalvisionoff", 32935);
-            Function.AddMapping("unknown", 32803);
-            Function.AddMapping("unknown", 32768);
-            Function.AddMapping("thermalvisionfofoverlayon", 32936);
-            Function.AddMapping("thermalvisionfofoverlayoff", 32937);
-            Function.AddMapping("autospotoverlayon", 32938);
-            Function.AddMapping("autospotoverlayoff", 32939);
-            Function.AddMapping("setcontents", 32940);
-            Function.AddMapping("makeusable", 32941);
-            Function.AddMapping("makeunusable", 32942);
-            Function.AddMapping("setcursorhint", 32966);
-            Function.AddMapping("sethintstring", 32967);
-            Function.AddMapping("forceusehinton", 32968);
-            Function.AddMapping("forceusehintoff", 32969);
-            Function.AddMapping("makesoft", 32970);
-            Function.AddMapping("makehard", 32971);
-            Function.AddMapping("willneverchange", 32972);
-            Function.AddMapping("startfiring", 32973);
-            Function.AddMapping("stopfiring", 32974);
-            Function.AddMapping("isfiringturret", 32975);
-            Function.AddMapping("startbarrelspin", 32976);
-            Function.AddMapping("stopbarrelspin", 32977);
-            Function.AddMapping("getbarrelspinrate", 32978);
-            Function.AddMapping("remotecontrolturret", 32979);
-            Function.AddMapping("remotecontrolturretoff", 32980);
-            Function.AddMapping("shootturret", 32981);
-            Function.AddMapping("getturretowner", 32982);
-            Function.AddMapping("setsentryowner", 33006);
-            Function.AddMapping("setsentrycarrier", 33007);
-            Function.AddMapping("setturretminimapvisible", 33008);
-            Function.AddMapping("settargetentity", 33009);
-            Function.AddMapping("snaptotargetentity", 33010);
-            Function.AddMapping("cleartargetentity", 33011);
-            Function.AddMapping("getturrettarget", 33012);
-            Function.AddMapping("setplayerspread", 33013);
-            Function.AddMapping("setaispread", 33014);
-            Function.AddMapping("setsuppressiontime", 33015);
-            Function.AddMapping("setconvergencetime", 33049);
-            Function.AddMapping("setconvergenceheightpercent", 33050);
-            Function.AddMapping("setturretteam", 33051);
-            Function.AddMapping("maketurretsolid", 33052);
-            Function.AddMapping("maketurretoperable", 33053);
-            Function.AddMapping("maketurretinoperable", 33054);
-            Function.AddMapping("setturretaccuracy", 33082);
-            Function.AddMapping("setrightarc", 33083);
-            Function.AddMapping("setleftarc", 33084);
-            Function.AddMapping("settoparc", 33085);
-            Function.AddMapping("setbottomarc", 33086);
-            Function.AddMapping("setautorotationdelay", 33087);
-            Function.AddMapping("setdefaultdroppitch", 33088);
-            Function.AddMapping("restoredefaultdroppitch", 33089);
-            Function.AddMapping("turretfiredisable", 33090);
-            Function.AddMapping("turretfireenable", 33121);
-            Function.AddMapping("setturretmodechangewait", 33122);
-            Function.AddMapping("usetriggerrequirelookat", 33123);
-            Function.AddMapping("getstance", 33124);
-            Function.AddMapping("setstance", 33125);
-            Function.AddMapping("itemweaponsetammo", 33126);
-            Function.AddMapping("getammocount", 33127);
-            Function.AddMapping("gettagorigin", 33128);
-            Function.AddMapping("gettagangles", 33129);
-            Function.AddMapping("shellshock", 33130);
-            Function.AddMapping("stunplayer", 33131);
-            Function.AddMapping("stopshellshock", 33132);
-            Function.AddMapping("fadeoutshellshock", 33133);
-            Function.AddMapping("setdepthoffield", 33134);
-            Function.AddMapping("setviewmodeldepthoffield", 33135);
-            Function.AddMapping("setmotionblurmovescale", 33136);
-            Function.AddMapping("setmotionblurturnscale", 33168);
-            Function.AddMapping("setmotionblurzoomscale", 33169);
-            Function.AddMapping("viewkick", 33170);
-            Function.AddMapping("localtoworldcoords", 33171);
-            Function.AddMapping("getentitynumber", 33172);
-            Function.AddMapping("getentityvelocity", 33173);
-            Function.AddMapping("enablegrenadetouchdamage", 33174);
-            Function.AddMapping("disablegrenadetouchdamage", 33175);
-            Function.AddMapping("enableaimassist", 33176);
-            Function.AddMapping("disableaimassist", 33207);
-            Function.AddMapping("radiusdamage", 33208);
-            Function.AddMapping("detonate", 33209);
-            Function.AddMapping("damageconetrace", 33210);
-            Function.AddMapping("sightconetrace", 33211);
-            Function.AddMapping("settargetent", 33212);
-            Function.AddMapping("settargetpos", 33213);
-            Function.AddMapping("cleartarget", 33214);
-            Function.AddMapping("setflightmodedirect", 33215);
-            Function.AddMapping("setflightmodetop", 33216);
-            Function.AddMapping("getlightintensity", 33217);
-            Function.AddMapping("setlightintensity", 33218);
-            Function.AddMapping("isragdoll", 33219);
-            Function.AddMapping("setmovespeedscale", 33220);
-            Function.AddMapping("cameralinkto", 33221);
-            Function.AddMapping("cameraunlink", 33222);
-            Function.AddMapping("controlslinkto", 33251);
-            Function.AddMapping("controlsunlink", 33252);
-            Function.AddMapping("makevehiclesolidcapsule", 33253);
-            Function.AddMapping("makevehiclesolidsphere", 33254);
-            Function.AddMapping("remotecontrolvehicle", 33256);
-            Function.AddMapping("remotecontrolvehicleoff", 33257);
-            Function.AddMapping("isfiringvehicleturret", 33258);
-            Function.AddMapping("drivevehicleandcontrolturret", 33259);
-            Function.AddMapping("drivevehicleandcontrolturretoff", 33260);
-            Function.AddMapping("getplayersetting", 33261);
-            Function.AddMapping("getlocalplayerprofiledata", 33262);
-            Function.AddMapping("setlocalplayerprofiledata", 33263);
-            Function.AddMapping("remotecamerasoundscapeon", 33264);
-            Function.AddMapping("remotecamerasoundscapeoff", 33265);
-            Function.AddMapping("radarjamon", 33266);
-            Function.AddMapping("radarjamoff", 33267);
-            Function.AddMapping("setmotiontrackervisible", 33268);
-            Function.AddMapping("getmotiontrackervisible", 33269);
-            Function.AddMapping("circle", 33270);
-            Function.AddMapping("getpointinbounds", 33271);
-            Function.AddMapping("transfermarkstonewscriptmodel", 33272);
-            Function.AddMapping("setwatersheeting", 33273);
-            Function.AddMapping("setweaponhudiconoverride", 33274);
-            Function.AddMapping("getweaponhudiconoverride", 33275);
-            Function.AddMapping("setempjammed", 33276);
-            Function.AddMapping("playersetexpfog", 33277);
-            Function.AddMapping("isitemunlocked", 33278);
-            Function.AddMapping("getplayerdata", 33279);
-            Function.AddMapping("setplayerdata", 33306);
+            Method("attach", 32791),
+            Method("attachshieldmodel", 32792),
+            Method("detach", 32804),
+            Method("detachshieldmodel", 32805),
+            Method("moveshieldmodel", 32806),
+            Method("detachall", 32807),
+            Method("getattachsize", 32808),
+            Method("getattachmodelname", 32809),
+            Method("getattachtagname", 32810),
+            Method("getattachignorecollision", 32835),
+            Method("hidepart", 32836),
+            Method("allinstances", 32837),
+            Method("hideallparts", 32838),
+            Method("showpart", 32839),
+            Method("showallparts", 32840),
+            Method("linkto", 32841),
+            Method("linktoblendtotag", 32842),
+            Method("unlink", 32843),
+            Method("islinked", 32867),
+            Method("enablelinkto", 32868),
+            Method("playerlinkto", 32885),
+            Method("playerlinktodelta", 32886),
+            Method("playerlinkweaponviewtodelta", 32887),
+            Method("playerlinktoabsolute", 32888),
+            Method("playerlinktoblend", 32889),
+            Method("playerlinkedoffsetenable", 32890),
+            Method("playerlinkedoffsetdisable", 32916),
+            Method("playerlinkedsetviewznear", 32917),
+            Method("playerlinkedsetusebaseangleforviewclamp", 32918),
+            Method("lerpviewangleclamp", 32919),
+            Method("setviewangleresistance", 32920),
+            Method("geteye", 32921),
+            Method("istouching", 32922),
+            Method("stoploopsound", 32923),
+            Method("stopsounds", 32924),
+            Method("playrumbleonentity", 32925),
+            Method("playrumblelooponentity", 32926),
+            Method("stoprumble", 32927),
+            Method("delete", 32928),
+            Method("setmodel", 32929),
+            Method("laseron", 32930),
+            Method("laseroff", 32931),
+            Method("laseraltviewon", 32932),
+            Method("laseraltviewoff", 32933),
+            Method("thermalvisionon", 32934),
+            Method("thermalvisionoff", 32935),
+            Method("unknown", 32803),
+            Method("unknown", 32768),
+            Method("thermalvisionfofoverlayon", 32936),
+            Method("thermalvisionfofoverlayoff", 32937),
+            Method("autospotoverlayon", 32938),
+            Method("autospotoverlayoff", 32939),
+            Method("setcontents", 32940),
+            Method("makeusable", 32941),
+            Method("makeunusable", 32942),
+            Method("setcursorhint", 32966),
+            Method("sethintstring", 32967),
+            Method("forceusehinton", 32968),
+            Method("forceusehintoff", 32969),
+            Method("makesoft", 32970),
+            Method("makehard", 32971),
+            Method("willneverchange", 32972),
+            Method("startfiring", 32973),
+            Method("stopfiring", 32974),
+            Method("isfiringturret", 32975),
+            Method("startbarrelspin", 32976),
+            Method("stopbarrelspin", 32977),
+            Method("getbarrelspinrate", 32978),
+            Method("remotecontrolturret", 32979),
+            Method("remotecontrolturretoff", 32980),
+            Method("shootturret", 32981),
+            Method("getturretowner", 32982),
+            Method("setsentryowner", 33006),
+            Method("setsentrycarrier", 33007),
+            Method("setturretminimapvisible", 33008),
+            Method("settargetentity", 33009),
+            Method("snaptotargetentity", 33010),
+            Method("cleartargetentity", 33011),
+            Method("getturrettarget", 33012),
+            Method("setplayerspread", 33013),
+            Method("setaispread", 33014),
+            Method("setsuppressiontime", 33015),
+            Method("setconvergencetime", 33049),
+            Method("setconvergenceheightpercent", 33050),
+            Method("setturretteam", 33051),
+            Method("maketurretsolid", 33052),
+            Method("maketurretoperable", 33053),
+            Method("maketurretinoperable", 33054),
+            Method("setturretaccuracy", 33082),
+            Method("setrightarc", 33083),
+            Method("setleftarc", 33084),
+            Method("settoparc", 33085),
+            Method("setbottomarc", 33086),
+            Method("setautorotationdelay", 33087),
+            Method("setdefaultdroppitch", 33088),
+            Method("restoredefaultdroppitch", 33089),
+            Method("turretfiredisable", 33090),
+            Method("turretfireenable", 33121),
+            Method("setturretmodechangewait", 33122),
+            Method("usetriggerrequirelookat", 33123),
+            Method("getstance", 33124),
+            Method("setstance", 33125),
+            Method("itemweaponsetammo", 33126),
+            Method("getammocount", 33127),
+            Method("gettagorigin", 33128),
+            Method("gettagangles", 33129),
+            Method("shellshock", 33130),
+            Method("stunplayer", 33131),
+            Method("stopshellshock", 33132),
+            Method("fadeoutshellshock", 33133),
+            Method("setdepthoffield", 33134),
+            Method("setviewmodeldepthoffield", 33135),
+            Method("setmotionblurmovescale", 33136),
+            Method("setmotionblurturnscale", 33168),
+            Method("setmotionblurzoomscale", 33169),
+            Method("viewkick", 33170),
+            Method("localtoworldcoords", 33171),
+            Method("getentitynumber", 33172),
+            Method("getentityvelocity", 33173),
+            Method("enablegrenadetouchdamage", 33174),
+            Method("disablegrenadetouchdamage", 33175),
+            Method("enableaimassist", 33176),
+            Method("disableaimassist", 33207),
+            Method("radiusdamage", 33208),
+            Method("detonate", 33209),
+            Method("damageconetrace", 33210),
+            Method("sightconetrace", 33211),
+            Method("settargetent", 33212),
+            Method("settargetpos", 33213),
+            Method("cleartarget", 33214),
+            Method("setflightmodedirect", 33215),
+            Method("setflightmodetop", 33216),
+            Method("getlightintensity", 33217),
+            Method("setlightintensity", 33218),
+            Method("isragdoll", 33219),
+            Method("setmovespeedscale", 33220),
+            Method("cameralinkto", 33221),
+            Method("cameraunlink", 33222),
+            Method("controlslinkto", 33251),
+            Method("controlsunlink", 33252),
+            Method("makevehiclesolidcapsule", 33253),
+            Method("makevehiclesolidsphere", 33254),
+            Method("remotecontrolvehicle", 33256),
+            Method("remotecontrolvehicleoff", 33257),
+            Method("isfiringvehicleturret", 33258),
+            Method("drivevehicleandcontrolturret", 33259),
+            Method("drivevehicleandcontrolturretoff", 33260),
+            Method("getplayersetting", 33261),
+            Method("getlocalplayerprofiledata", 33262),
+            Method("setlocalplayerprofiledata", 33263),
+            Method("remotecamerasoundscapeon", 33264),
+            Method("remotecamerasoundscapeoff", 33265),
+            Method("radarjamon", 33266),
+            Method("radarjamoff", 33267),
+            Method("setmotiontrackervisible", 33268),
+            Method("getmotiontrackervisible", 33269),
+            Method("circle", 33270),
+            Method("getpointinbounds", 33271),
+            Method("transfermarkstonewscriptmodel", 33272),
+            Method("setwatersheeting", 33273),
+            Method("setweaponhudiconoverride", 33274),
+            Method("getweaponhudiconoverride", 33275),
+            Method("setempjammed", 33276),
+            Method("playersetexpfog", 33277),
+            Method("isitemunlocked", 33278),
+            Method("getplayerdata", 33279),
+            Method("setplayerdata", 33306),
 
             // some entity (script_model) stuff
-            Function.AddMapping("moveto", 33399);
-            Function.AddMapping("movex", 33400);
-            Function.AddMapping("movey", 33401);
-            Function.AddMapping("movez", 33402);
-            Function.AddMapping("movegravity", 33403);
-            Function.AddMapping("moveslide", 33404);
-            Function.AddMapping("stopmoveslide", 33405);
-            Function.AddMapping("rotateto", 33406);
-            Function.AddMapping("rotatepitch", 33407);
-            Function.AddMapping("rotateyaw", 33408);
-            Function.AddMapping("rotateroll", 33409);
-            Function.AddMapping("addpitch", 33410);
-            Function.AddMapping("addyaw", 33411);
-            Function.AddMapping("addroll", 33412);
-            Function.AddMapping("vibrate", 33413);
-            Function.AddMapping("rotatevelocity", 33414);
-            Function.AddMapping("solid", 33415);
-            Function.AddMapping("notsolid", 33416);
-            Function.AddMapping("setcandamage", 33417);
-            Function.AddMapping("setcanradiusdamage", 33418);
-            Function.AddMapping("physicslaunchclient", 33419);
-            Function.AddMapping("physicslaunchserver", 33351);
-            Function.AddMapping("physicslaunchserveritem", 33352);
-            Function.AddMapping("clonebrushmodeltoscriptmodel", 33353);
-            Function.AddMapping("scriptmodelplayanim", 33354);
-            Function.AddMapping("scriptmodelclearanim", 33355);
+            Method("moveto", 33399),
+            Method("movex", 33400),
+            Method("movey", 33401),
+            Method("movez", 33402),
+            Method("movegravity", 33403),
+            Method("moveslide", 33404),
+            Method("stopmoveslide", 33405),
+            Method("rotateto", 33406),
+            Method("rotatepitch", 33407),
+            Method("rotateyaw", 33408),
+            Method("rotateroll", 33409),
+            Method("addpitch", 33410),
+            Method("addyaw", 33411),
+            Method("addroll", 33412),
+            Method("vibrate", 33413),
+            Method("rotatevelocity", 33414),
+            Method("solid", 33415),
+            Method("notsolid", 33416),
+            Method("setcandamage", 33417),
+            Method("setcanradiusdamage", 33418),
+            Method("physicslaunchclient", 33419),
+            Method("physicslaunchserver", 33351),
+            Method("physicslaunchserveritem", 33352),
+            Method("clonebrushmodeltoscriptmodel", 33353),
+            Method("scriptmodelplayanim", 33354),
+            Method("scriptmodelclearanim", 33355),
 
             // varied ent/player script commands
-            Function.AddMapping("getorigin", 32910);
-            Function.AddMapping("useby", 32914);
-            Function.AddMapping("playsound", 32915);
-            Function.AddMapping("playsoundasmaster", 32878);
-            Function.AddMapping("playsoundtoteam", 32771);
-            Function.AddMapping("playsoundtoplayer", 32772);
-            Function.AddMapping("playloopsound", 32879);
-            Function.AddMapping("getnormalhealth", 32884);
-            Function.AddMapping("setnormalhealth", 32844);
-            Function.AddMapping("show", 32847);
-            Function.AddMapping("hide", 32848);
-            Function.AddMapping("playerhide", 32773);
-            Function.AddMapping("showtoplayer", 32774);
-            Function.AddMapping("enableplayeruse", 32775);
-            Function.AddMapping("disableplayeruse", 32776);
-            Function.AddMapping("makescrambler_unk", 33546);
-            Function.AddMapping("makeportableradar_unk", 32777);
-            Function.AddMapping("maketrophysystem_unk", 32778);
-            Function.AddMapping("makeunk", 32779);
-            Function.AddMapping("setmode", 32864);
-            Function.AddMapping("getmode", 32865);
-            Function.AddMapping("placespawnpoint", 32780);
-            Function.AddMapping("setteamfortrigger", 32781);
-            Function.AddMapping("clientclaimtrigger", 32782);
-            Function.AddMapping("clientreleasetrigger", 32783);
-            Function.AddMapping("releaseclaimedtrigger", 32784);
-            Function.AddMapping("isusingonlinedataoffline", 32785);
-            Function.AddMapping("getrestedtime", 32786);
-            Function.AddMapping("send73command_unk", 32787);
-            Function.AddMapping("sendleaderboards", 32800);
-            Function.AddMapping("isonladder", 32788);
-            Function.AddMapping("startragdoll", 32798);
-            Function.AddMapping("getcorpseanim", 32789);
-            Function.AddMapping("playerforcedeathanim", 32790);
-            Function.AddMapping("startac130", 33543);
-            Function.AddMapping("stopac130", 33544);
+            Method("getorigin", 32910),
+            Method("useby", 32914),
+            Method("playsound", 32915),
+            Method("playsoundasmaster", 32878),
+            Method("playsoundtoteam", 32771),
+            Method("playsoundtoplayer", 32772),
+            Method("playloopsound", 32879),
+            Method("getnormalhealth", 32884),
+            Method("setnormalhealth", 32844),
+            Method("show", 32847),
+            Method("hide", 32848),
+            Method("playerhide", 32773),
+            Method("showtoplayer", 32774),
+            Method("enableplayeruse", 32775),
+            Method("disableplayeruse", 32776),
+            Method("makescrambler_unk", 33546),
+            Method("makeportableradar_unk", 32777),
+            Method("maketrophysystem_unk", 32778),
+            Method("makeunk", 32779),
+            Method("setmode", 32864),
+            Method("getmode", 32865),
+            Method("placespawnpoint", 32780),
+            Method("setteamfortrigger", 32781),
+            Method("clientclaimtrigger", 32782),
+            Method("clientreleasetrigger", 32783),
+            Method("releaseclaimedtrigger", 32784),
+            Method("isusingonlinedataoffline", 32785),
+            Method("getrestedtime", 32786),
+            Method("send73command_unk", 32787),
+            Method("sendleaderboards", 32800),
+            Method("isonladder", 32788),
+            Method("startragdoll", 32798),
+            Method("getcorpseanim", 32789),
+            Method("playerforcedeathanim", 32790),
+            Method("startac130", 33543),
+            Method("stopac130", 33544),
 
             // global stuff #1
-            Function.AddGlobalMapping("iprintln", 362);
-            Function.AddGlobalMapping("iprintlnbold", 363);
-            Function.AddGlobalMapping("logstring", 364);
-            Function.AddGlobalMapping("getent", 365);
-            Function.AddGlobalMapping("getentarray", 366);
-            Function.AddGlobalMapping("spawnplane", 367);
-            Function.AddGlobalMapping("spawnstruct", 368);
-            Function.AddGlobalMapping("spawnhelicopter", 369);
-            Function.AddGlobalMapping("isalive", 370);
-            Function.AddGlobalMapping("isspawner", 371);
-            Function.AddGlobalMapping("createattractorent", 372);
-            Function.AddGlobalMapping("createattractororigin", 373);
-            Function.AddGlobalMapping("createrepulsorent", 374);
-            Function.AddGlobalMapping("createrepulsororigin", 375);
-            Function.AddGlobalMapping("deleteattractor", 376);
-            Function.AddGlobalMapping("playsoundatpos", 377);
-            Function.AddGlobalMapping("newhudelem", 378);
-            Function.AddGlobalMapping("newclienthudelem", 379);
-            Function.AddGlobalMapping("newteamhudelem", 380);
-            Function.AddGlobalMapping("resettimeout", 381);
-            Function.AddGlobalMapping("precachefxteamthermal", 382);
-            Function.AddGlobalMapping("isplayer", 383);
-            Function.AddGlobalMapping("isplayernumber", 384);
-            Function.AddGlobalMapping("setsunlight", 57);
-            Function.AddGlobalMapping("resetsunlight", 58);
-            Function.AddGlobalMapping("setwinningplayer", 385);
-            Function.AddGlobalMapping("setwinningteam", 311);
-            Function.AddGlobalMapping("announcement", 312);
-            Function.AddGlobalMapping("clientannouncement", 313);
-            Function.AddGlobalMapping("getteamscore", 314);
-            Function.AddGlobalMapping("setteamscore", 315);
-            Function.AddGlobalMapping("setclientnamemode", 316);
-            Function.AddGlobalMapping("updateclientnames", 317);
-            Function.AddGlobalMapping("getteamplayersalive", 318);
-            Function.AddGlobalMapping("logprint", 319);
-            Function.AddGlobalMapping("worldentnumber", 320);
-            Function.AddGlobalMapping("obituary", 321);
-            Function.AddGlobalMapping("positionwouldtelefrag", 322);
-            Function.AddGlobalMapping("canspawn", 323);
-            Function.AddGlobalMapping("getstarttime", 324);
-            Function.AddGlobalMapping("precachestatusicon", 325);
-            Function.AddGlobalMapping("precacheminimapicon", 327);
-            Function.AddGlobalMapping("precachempanim", 328);
-            Function.AddGlobalMapping("restart", 329);
-            Function.AddGlobalMapping("exitlevel", 330);
-            Function.AddGlobalMapping("addtestclient", 331);
-            Function.AddGlobalMapping("makedvarserverinfo", 332);
-            Function.AddGlobalMapping("setarchive", 333);
-            Function.AddGlobalMapping("allclientsprint", 334);
-            Function.AddGlobalMapping("clientprint", 335);
-            Function.AddGlobalMapping("mapexists", 336);
-            Function.AddGlobalMapping("isvalidgametype", 337);
-            Function.AddGlobalMapping("matchend", 338);
-            Function.AddGlobalMapping("setplayerteamrank", 339);
-            Function.AddGlobalMapping("endparty", 340);
-            Function.AddGlobalMapping("setteamradar", 341);
-            Function.AddGlobalMapping("getteamradar", 342);
-            Function.AddGlobalMapping("setteamradarstrength", 343);
-            Function.AddGlobalMapping("getteamradarstrength", 344);
-            Function.AddGlobalMapping("getuavstrengthmin", 345);
-            Function.AddGlobalMapping("getuavstrengthmax", 262);
-            Function.AddGlobalMapping("getuavstrengthlevelneutral", 263);
-            Function.AddGlobalMapping("getuavstrengthlevelshowenemyfastsweep", 264);
-            Function.AddGlobalMapping("getuavstrengthlevelshowenemydirectional", 265);
-            Function.AddGlobalMapping("blockteamradar", 266);
-            Function.AddGlobalMapping("unblockteamradar", 267);
-            Function.AddGlobalMapping("isteamradarblocked", 268);
-            Function.AddGlobalMapping("getassignedteam", 269);
-            Function.AddGlobalMapping("setmatchdata", 270);
-            Function.AddGlobalMapping("getmatchdata", 271);
-            Function.AddGlobalMapping("sendmatchdata", 272);
-            Function.AddGlobalMapping("clearmatchdata", 273);
-            Function.AddGlobalMapping("setmatchdatadef", 274);
-            Function.AddGlobalMapping("setmatchclientip", 275);
-            Function.AddGlobalMapping("setmatchdataid", 276);
-            Function.AddGlobalMapping("setclientmatchdata", 277);
-            Function.AddGlobalMapping("getclientmatchdata", 278);
-            Function.AddGlobalMapping("setclientmatchdatadef", 279);
-            Function.AddGlobalMapping("sendclientmatchdata", 280);
-            Function.AddGlobalMapping("getbuildversion", 281);
-            Function.AddGlobalMapping("getbuildnumber", 282);
-            Function.AddGlobalMapping("getsystemtime", 283);
-            Function.AddGlobalMapping("getmatchrulesdata", 284);
-            Function.AddGlobalMapping("isusingmatchrulesdata", 285);
-            Function.AddGlobalMapping("kick", 286);
-            Function.AddGlobalMapping("issplitscreen", 287);
-            Function.AddGlobalMapping("setmapcenter", 288);
-            Function.AddGlobalMapping("setgameendtime", 289);
-            Function.AddGlobalMapping("visionsetnaked", 290);
-            Function.AddGlobalMapping("visionsetnight", 291);
-            Function.AddGlobalMapping("visionsetmissilecam", 292);
-            Function.AddGlobalMapping("visionsetthermal", 217);
-            Function.AddGlobalMapping("visionsetpain", 218);
-            Function.AddGlobalMapping("endlobby", 219);
-            Function.AddGlobalMapping("ambience", 220);
-            Function.AddGlobalMapping("getmapcustom", 221);
-            Function.AddGlobalMapping("updateskill", 222);
-            Function.AddGlobalMapping("spawnsighttrace", 223);
+            Global("iprintln", 362),
+            Global("iprintlnbold", 363),
+            Global("logstring", 364),
+            Global("getent", 365),
+            Global("getentarray", 366),
+            Global("spawnplane", 367),
+            Global("spawnstruct", 368),
+            Global("spawnhelicopter", 369),
+            Global("isalive", 370),
+            Global("isspawner", 371),
+            Global("createattractorent", 372),
+            Global("createattractororigin", 373),
+            Global("createrepulsorent", 374),
+            Global("createrepulsororigin", 375),
+            Global("deleteattractor", 376),
+            Global("playsoundatpos", 377),
+            Global("newhudelem", 378),
+            Global("newclienthudelem", 379),
+            Global("newteamhudelem", 380),
+            Global("resettimeout", 381),
+            Global("precachefxteamthermal", 382),
+            Global("isplayer", 383),
+            Global("isplayernumber", 384),
+            Global("setsunlight", 57),
+            Global("resetsunlight", 58),
+            Global("setwinningplayer", 385),
+            Global("setwinningteam", 311),
+            Global("announcement", 312),
+            Global("clientannouncement", 313),
+            Global("getteamscore", 314),
+            Global("setteamscore", 315),
+            Global("setclientnamemode", 316),
+            Global("updateclientnames", 317),
+            Global("getteamplayersalive", 318),
+            Global("logprint", 319),
+            Global("worldentnumber", 320),
+            Global("obituary", 321),
+            Global("positionwouldtelefrag", 322),
+            Global("canspawn", 323),
+            Global("getstarttime", 324),
+            Global("precachestatusicon", 325),
+            Global("precacheminimapicon", 327),
+            Global("precachempanim", 328),
+            Global("restart", 329),
+            Global("exitlevel", 330),
+            Global("addtestclient", 331),
+            Global("makedvarserverinfo", 332),
+            Global("setarchive", 333),
+            Global("allclientsprint", 334),
+            Global("clientprint", 335),
+            Global("mapexists", 336),
+            Global("isvalidgametype", 337),
+            Global("matchend", 338),
+            Global("setplayerteamrank", 339),
+            Global("endparty", 340),
+            Global("setteamradar", 341),
+            Global("getteamradar", 342),
+            Global("setteamradarstrength", 343),
+            Global("getteamradarstrength", 344),
+            Global("getuavstrengthmin", 345),
+            Global("getuavstrengthmax", 262),
+            Global("getuavstrengthlevelneutral", 263),
+            Global("getuavstrengthlevelshowenemyfastsweep", 264),
+            Global("getuavstrengthlevelshowenemydirectional", 265),
+            Global("blockteamradar", 266),
+            Global("unblockteamradar", 267),
+            Global("isteamradarblocked", 268),
+            Global("getassignedteam", 269),
+            Global("setmatchdata", 270),
+            Global("getmatchdata", 271),
+            Global("sendmatchdata", 272),
+            Global("clearmatchdata", 273),
+            Global("setmatchdatadef", 274),
+            Global("setmatchclientip", 275),
+            Global("setmatchdataid", 276),
+            Global("setclientmatchdata", 277),
+            Global("getclientmatchdata", 278),
+            Global("setclientmatchdatadef", 279),
+            Global("sendclientmatchdata", 280),
+            Global("getbuildversion", 281),
+            Global("getbuildnumber", 282),
+            Global("getsystemtime", 283),
+            Global("getmatchrulesdata", 284),
+            Global("isusingmatchrulesdata", 285),
+            Global("kick", 286),
+            Global("issplitscreen", 287),
+            Global("setmapcenter", 288),
+            Global("setgameendtime", 289),
+            Global("visionsetnaked", 290),
+            Global("visionsetnight", 291),
+            Global("visionsetmissilecam", 292),
+            Global("visionsetthermal", 217),
+            Global("visionsetpain", 218),
+            Global("endlobby", 219),
+            Global("ambience", 220),
+            Global("getmapcustom", 221),
+            Global("updateskill", 222),
+            Global("spawnsighttrace", 223),
 
             // global stuff #2
-            Function.AddGlobalMapping("setprintchannel", 14);
-            Function.AddGlobalMapping("print", 15);
-            Function.AddGlobalMapping("println", 16);
-            Function.AddGlobalMapping("print3d", 17);
-            Function.AddGlobalMapping("line", 18);
-            Function.AddGlobalMapping("spawnturret", 19);
-            Function.AddGlobalMapping("canspawnturret", 20);
-            Function.AddGlobalMapping("assert", 21);
-            Function.AddGlobalMapping("assertex", 38);
-            Function.AddGlobalMapping("assertmsg", 39);
-            Function.AddGlobalMapping("isdefined", 40);
-            Function.AddGlobalMapping("isstring", 41);
-            Function.AddGlobalMapping("setdvar", 42);
-            Function.AddGlobalMapping("setdynamicdvar", 43);
-            Function.AddGlobalMapping("setdvarifuninitialized", 44);
-            Function.AddGlobalMapping("setdevdvar", 45);
-            Function.AddGlobalMapping("setdevdvarifuninitialized", 46);
-            Function.AddGlobalMapping("getdvar", 47);
-            Function.AddGlobalMapping("getdvarint", 48);
-            Function.AddGlobalMapping("getdvarfloat", 49);
-            Function.AddGlobalMapping("getdvarvector", 50);
-            Function.AddGlobalMapping("gettime", 51);
-            Function.AddGlobalMapping("getentbynum", 52);
-            Function.AddGlobalMapping("getweaponmodel", 53);
-            Function.AddGlobalMapping("getweaponhidetags", 81);
-            Function.AddGlobalMapping("getanimlength", 82);
-            Function.AddGlobalMapping("animhasnotetrack", 83);
-            Function.AddGlobalMapping("getnotetracktimes", 84);
-            Function.AddGlobalMapping("spawn", 85);
-            Function.AddGlobalMapping("spawnloopsound", 86);
-            Function.AddGlobalMapping("bullettrace", 87);
-            Function.AddGlobalMapping("bullettracepassed", 88);
-            Function.AddGlobalMapping("sighttracepassed", 116);
-            Function.AddGlobalMapping("physicstrace", 117);
-            Function.AddGlobalMapping("physicstracenormal", 118);
-            Function.AddGlobalMapping("playerphysicstrace", 119);
-            Function.AddGlobalMapping("getgroundposition", 120);
-            Function.AddGlobalMapping("getmovedelta", 121);
-            Function.AddGlobalMapping("getangledelta", 122);
-            Function.AddGlobalMapping("getnorthyaw", 123);
-            Function.AddGlobalMapping("setnorthyaw", 150);
-            Function.AddGlobalMapping("setslowmotion", 151);
-            Function.AddGlobalMapping("randomint", 152);
-            Function.AddGlobalMapping("randomfloat", 153);
-            Function.AddGlobalMapping("randomintrange", 154);
-            Function.AddGlobalMapping("randomfloatrange", 155);
-            Function.AddGlobalMapping("sin", 156);
-            Function.AddGlobalMapping("cos", 157);
-            Function.AddGlobalMapping("tan", 158);
-            Function.AddGlobalMapping("asin", 159);
-            Function.AddGlobalMapping("acos", 160);
-            Function.AddGlobalMapping("atan", 161);
-            Function.AddGlobalMapping("int", 162);
-            Function.AddGlobalMapping("float", 163);
-            Function.AddGlobalMapping("abs", 164);
-            Function.AddGlobalMapping("min", 165);
-            Function.AddGlobalMapping("max", 198);
-            Function.AddGlobalMapping("floor", 199);
-            Function.AddGlobalMapping("ceil", 200);
-            Function.AddGlobalMapping("exp", 201);
-            Function.AddGlobalMapping("log", 202);
-            Function.AddGlobalMapping("sqrt", 203);
-            Function.AddGlobalMapping("squared", 204);
-            Function.AddGlobalMapping("clamp", 205);
-            Function.AddGlobalMapping("angleclamp", 206);
-            Function.AddGlobalMapping("angleclamp180", 207);
-            Function.AddGlobalMapping("vectorfromlinetopoint", 208);
-            Function.AddGlobalMapping("pointonsegmentnearesttopoint", 209);
-            Function.AddGlobalMapping("distance", 210);
-            Function.AddGlobalMapping("distance2d", 211);
-            Function.AddGlobalMapping("distancesquared", 212);
-            Function.AddGlobalMapping("length", 213);
-            Function.AddGlobalMapping("lengthsquared", 214);
-            Function.AddGlobalMapping("closer", 215);
-            Function.AddGlobalMapping("vectordot", 216);
-            Function.AddGlobalMapping("vectornormalize", 246);
-            Function.AddGlobalMapping("vectortoangles", 247);
-            Function.AddGlobalMapping("vectortoyaw", 248);
-            Function.AddGlobalMapping("vectorlerp", 249);
-            Function.AddGlobalMapping("anglestoup", 250);
-            Function.AddGlobalMapping("anglestoright", 251);
-            Function.AddGlobalMapping("anglestoforward", 252);
-            Function.AddGlobalMapping("combineangles", 253);
-            Function.AddGlobalMapping("transformmove", 254);
-            Function.AddGlobalMapping("issubstr", 255);
-            Function.AddGlobalMapping("isendstr", 256);
-            Function.AddGlobalMapping("getsubstr", 257);
-            Function.AddGlobalMapping("tolower", 258);
-            Function.AddGlobalMapping("strtok", 259);
-            Function.AddGlobalMapping("stricmp", 260);
-            Function.AddGlobalMapping("ambientplay", 261);
-            Function.AddGlobalMapping("ambientstop", 293);
-            Function.AddGlobalMapping("precachemodel", 294);
-            Function.AddGlobalMapping("precacheshellshock", 295);
-            Function.AddGlobalMapping("precacheitem", 296);
-            Function.AddGlobalMapping("precacheshader", 297);
-            Function.AddGlobalMapping("precachestring", 298);
-            Function.AddGlobalMapping("precachemenu", 299);
-            Function.AddGlobalMapping("precacherumble", 300);
-            Function.AddGlobalMapping("precachelocationselector", 301);
-            Function.AddGlobalMapping("precacheleaderboards", 302);
-            Function.AddGlobalMapping("precacheheadicon", 326);
-            Function.AddGlobalMapping("loadfx", 303);
-            Function.AddGlobalMapping("playfx", 304);
-            Function.AddGlobalMapping("playfxontag", 305);
-            Function.AddGlobalMapping("stopfxontag", 306);
-            Function.AddGlobalMapping("playloopedfx", 307);
-            Function.AddGlobalMapping("spawnfx", 308);
-            Function.AddGlobalMapping("triggerfx", 309);
-            Function.AddGlobalMapping("playfxontagforclients", 310);
-            Function.AddGlobalMapping("physicsexplosionsphere", 346);
-            Function.AddGlobalMapping("physicsexplosioncylinder", 347);
-            Function.AddGlobalMapping("physicsjolt", 348);
-            Function.AddGlobalMapping("physicsjitter", 349);
-            Function.AddGlobalMapping("setexpfog", 350);
-            Function.AddGlobalMapping("isexplosivedamagemod", 351);
-            Function.AddGlobalMapping("radiusdamage", 352);
-            Function.AddGlobalMapping("setplayerignoreradiusdamage", 353);
-            Function.AddGlobalMapping("glassradiusdamage", 354);
-            Function.AddGlobalMapping("earthquake", 355);
-            Function.AddGlobalMapping("getnumparts", 356);
-            Function.AddGlobalMapping("getpartname", 386);
-            Function.AddGlobalMapping("weaponfiretime", 387);
-            Function.AddGlobalMapping("weaponclipsize", 388);
-            Function.AddGlobalMapping("weaponisauto", 389);
-            Function.AddGlobalMapping("weaponissemiauto", 390);
-            Function.AddGlobalMapping("weaponisboltaction", 391);
-            Function.AddGlobalMapping("weaponinheritsperks", 392);
-            Function.AddGlobalMapping("weaponburstcount", 393);
-            Function.AddGlobalMapping("weapontype", 394);
-            Function.AddGlobalMapping("weaponclass", 395);
-            Function.AddGlobalMapping("weaponinventorytype", 437);
-            Function.AddGlobalMapping("weaponstartammo", 438);
-            Function.AddGlobalMapping("weaponmaxammo", 439);
-            Function.AddGlobalMapping("weaponaltweaponname", 440);
-            Function.AddGlobalMapping("isweaponcliponly", 441);
-            Function.AddGlobalMapping("isweapondetonationtimed", 442);
-            Function.AddGlobalMapping("weaponhasthermalscope", 443);
-            Function.AddGlobalMapping("getvehiclenode", 444);
-            Function.AddGlobalMapping("getvehiclenodearray", 445);
-            Function.AddGlobalMapping("getallvehiclenodes", 446);
-            Function.AddGlobalMapping("getnumvehicles", 447);
-            Function.AddGlobalMapping("precachevehicle", 448);
-            Function.AddGlobalMapping("spawnvehicle", 449);
-            Function.AddGlobalMapping("getarray", 450);
-            Function.AddGlobalMapping("getspawnerarray", 408);
-            Function.AddGlobalMapping("playrumbleonposition", 409);
-            Function.AddGlobalMapping("playrumblelooponposition", 410);
-            Function.AddGlobalMapping("stopallrumbles", 411);
-            Function.AddGlobalMapping("soundexists", 412);
-            Function.AddGlobalMapping("openfile", 413);
-            Function.AddGlobalMapping("closefile", 414);
-            Function.AddGlobalMapping("fprintln", 415);
-            Function.AddGlobalMapping("fprintfields", 416);
-            Function.AddGlobalMapping("freadln", 417);
-            Function.AddGlobalMapping("fgetarg", 418);
-            Function.AddGlobalMapping("setminimap", 419);
-            Function.AddGlobalMapping("setthermalbodymaterial", 420);
-            Function.AddGlobalMapping("getarraykeys", 421);
-            Function.AddGlobalMapping("getfirstarraykey", 422);
-            Function.AddGlobalMapping("getnextarraykey", 396);
-            Function.AddGlobalMapping("sortbydistance", 397);
-            Function.AddGlobalMapping("tablelookup", 398);
-            Function.AddGlobalMapping("tablelookupbyrow", 399);
-            Function.AddGlobalMapping("tablelookupistring", 400);
-            Function.AddGlobalMapping("tablelookupistringbyrow", 401);
-            Function.AddGlobalMapping("tablelookuprownum", 402);
-            Function.AddGlobalMapping("getmissileowner", 403);
-            Function.AddGlobalMapping("magicbullet", 404);
-            Function.AddGlobalMapping("getweaponflashtagname", 405);
-            Function.AddGlobalMapping("averagepoint", 406);
-            Function.AddGlobalMapping("averagenormal", 407);
-            Function.AddGlobalMapping("getglass", 423);
-            Function.AddGlobalMapping("getglassarray", 424);
-            Function.AddGlobalMapping("getglassorigin", 425);
-            Function.AddGlobalMapping("isglassdestroyed", 426);
-            Function.AddGlobalMapping("destroyglass", 427);
-            Function.AddGlobalMapping("deleteglass", 428);
-            Function.AddGlobalMapping("getentchannelscount", 429);
+            Global("setprintchannel", 14),
+            Global("print", 15),
+            Global("println", 16),
+            Global("print3d", 17),
+            Global("line", 18),
+            Global("spawnturret", 19),
+            Global("canspawnturret", 20),
+            Global("assert", 21),
+            Global("assertex", 38),
+            Global("assertmsg", 39),
+            Global("isdefined", 40),
+            Global("isstring", 41),
+            Global("setdvar", 42),
+            Global("setdynamicdvar", 43),
+            Global("setdvarifuninitialized", 44),
+            Global("setdevdvar", 45),
+            Global("setdevdvarifuninitialized", 46),
+            Global("getdvar", 47),
+            Global("getdvarint", 48),
+            Global("getdvarfloat", 49),
+            Global("getdvarvector", 50),
+            Global("gettime", 51),
+            Global("getentbynum", 52),
+            Global("getweaponmodel", 53),
+            Global("getweaponhidetags", 81),
+            Global("getanimlength", 82),
+            Global("animhasnotetrack", 83),
+            Global("getnotetracktimes", 84),
+            Global("spawn", 85),
+            Global("spawnloopsound", 86),
+            Global("bullettrace", 87),
+            Global("bullettracepassed", 88),
+            Global("sighttracepassed", 116),
+            Global("physicstrace", 117),
+            Global("physicstracenormal", 118),
+            Global("playerphysicstrace", 119),
+            Global("getgroundposition", 120),
+            Global("getmovedelta", 121),
+            Global("getangledelta", 122),
+            Global("getnorthyaw", 123),
+            Global("setnorthyaw", 150),
+            Global("setslowmotion", 151),
+            Global("randomint", 152),
+            Global("randomfloat", 153),
+            Global("randomintrange", 154),
+            Global("randomfloatrange", 155),
+            Global("sin", 156),
+            Global("cos", 157),
+            Global("tan", 158),
+            Global("asin", 159),
+            Global("acos", 160),
+            Global("atan", 161),
+            Global("int", 162),
+            Global("float", 163),
+            Global("abs", 164),
+            Global("min", 165),
+            Global("max", 198),
+            Global("floor", 199),
+            Global("ceil", 200),
+            Global("exp", 201),
+            Global("log", 202),
+            Global("sqrt", 203),
+            Global("squared", 204),
+            Global("clamp", 205),
+            Global("angleclamp", 206),
+            Global("angleclamp180", 207),
+            Global("vectorfromlinetopoint", 208),
+            Global("pointonsegmentnearesttopoint", 209),
+            Global("distance", 210),
+            Global("distance2d", 211),
+            Global("distancesquared", 212),
+            Global("length", 213),
+            Global("lengthsquared", 214),
+            Global("closer", 215),
+            Global("vectordot", 216),
+            Global("vectornormalize", 246),
+            Global("vectortoangles", 247),
+            Global("vectortoyaw", 248),
+            Global("vectorlerp", 249),
+            Global("anglestoup", 250),
+            Global("anglestoright", 251),
+            Global("anglestoforward", 252),
+            Global("combineangles", 253),
+            Global("transformmove", 254),
+            Global("issubstr", 255),
+            Global("isendstr", 256),
+            Global("getsubstr", 257),
+            Global("tolower", 258),
+            Global("strtok", 259),
+            Global("stricmp", 260),
+            Global("ambientplay", 261),
+            Global("ambientstop", 293),
+            Global("precachemodel", 294),
+            Global("precacheshellshock", 295),
+            Global("precacheitem", 296),
+            Global("precacheshader", 297),
+            Global("precachestring", 298),
+            Global("precachemenu", 299),
+            Global("precacherumble", 300),
+            Global("precachelocationselector", 301),
+            Global("precacheleaderboards", 302),
+            Global("precacheheadicon", 326),
+            Global("loadfx", 303),
+            Global("playfx", 304),
+            Global("playfxontag", 305),
+            Global("stopfxontag", 306),
+            Global("playloopedfx", 307),
+            Global("spawnfx", 308),
+            Global("triggerfx", 309),
+            Global("playfxontagforclients", 310),
+            Global("physicsexplosionsphere", 346),
+            Global("physicsexplosioncylinder", 347),
+            Global("physicsjolt", 348),
+            Global("physicsjitter", 349),
+            Global("setexpfog", 350),
+            Global("isexplosivedamagemod", 351),
+            Global("radiusdamage", 352),
+            Global("setplayerignoreradiusdamage", 353),
+            Global("glassradiusdamage", 354),
+            Global("earthquake", 355),
+            Global("getnumparts", 356),
+            Global("getpartname", 386),
+            Global("weaponfiretime", 387),
+            Global("weaponclipsize", 388),
+            Global("weaponisauto", 389),
+            Global("weaponissemiauto", 390),
+            Global("weaponisboltaction", 391),
+            Global("weaponinheritsperks", 392),
+            Global("weaponburstcount", 393),
+            Global("weapontype", 394),
+            Global("weaponclass", 395),
+            Global("weaponinventorytype", 437),
+            Global("weaponstartammo", 438),
+            Global("weaponmaxammo", 439),
+            Global("weaponaltweaponname", 440),
+            Global("isweaponcliponly", 441),
+            Global("isweapondetonationtimed", 442),
+            Global("weaponhasthermalscope", 443),
+            Global("getvehiclenode", 444),
+            Global("getvehiclenodearray", 445),
+            Global("getallvehiclenodes", 446),
+            Global("getnumvehicles", 447),
+            Global("precachevehicle", 448),
+            Global("spawnvehicle", 449),
+            Global("getarray", 450),
+            Global("getspawnerarray", 408),
+            Global("playrumbleonposition", 409),
+            Global("playrumblelooponposition", 410),
+            Global("stopallrumbles", 411),
+            Global("soundexists", 412),
+            Global("openfile", 413),
+            Global("closefile", 414),
+            Global("fprintln", 415),
+            Global("fprintfields", 416),
+            Global("freadln", 417),
+            Global("fgetarg", 418),
+            Global("setminimap", 419),
+            Global("setthermalbodymaterial", 420),
+            Global("getarraykeys", 421),
+            Global("getfirstarraykey", 422),
+            Global("getnextarraykey", 396),
+            Global("sortbydistance", 397),
+            Global("tablelookup", 398),
+            Global("tablelookupbyrow", 399),
+            Global("tablelookupistring", 400),
+            Global("tablelookupistringbyrow", 401),
+            Global("tablelookuprownum", 402),
+            Global("getmissileowner", 403),
+            Global("magicbullet", 404),
+            Global("getweaponflashtagname", 405),
+            Global("averagepoint", 406),
+            Global("averagenormal", 407),
+            Global("getglass", 423),
+            Global("getglassarray", 424),
+            Global("getglassorigin", 425),
+            Global("isglassdestroyed", 426),
+            Global("destroyglass", 427),
+            Global("deleteglass", 428),
+            Global("getentchannelscount", 429),
 
             // objective
-            Function.AddGlobalMapping("objective_add", 431);
-            Function.AddGlobalMapping("objective_delete", 432);
-            Function.AddGlobalMapping("objective_state", 433);
-            Function.AddGlobalMapping("objective_icon", 434);
-            Function.AddGlobalMapping("objective_position", 435);
-            Function.AddGlobalMapping("objective_current", 436);
-            Function.AddGlobalMapping("objective_onentity", 357);
-            Function.AddGlobalMapping("objective_team", 358);
-            Function.AddGlobalMapping("objective_player", 359);
-            Function.AddGlobalMapping("objective_playerteam", 360);
-            Function.AddGlobalMapping("objective_playerenemyteam", 361);
-        }
+            Global("objective_add", 431),
+            Global("objective_delete", 432),
+            Global("objective_state", 433),
+            Global("objective_icon", 434),
+            Global("objective_position", 435),
+            Global("objective_current", 436),
+            Global("objective_onentity", 357),
+            Global("objective_team", 358),
+            Global("objective_player", 359),
+            Global("objective_playerteam", 360),
+            Global("objective_playerenemyteam", 361)
+        };
     }
 }
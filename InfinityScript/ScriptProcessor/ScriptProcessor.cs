@@ -14,20 +14,57 @@ namespace InfinityScript
             _scripts.Add(script);
         }
 
-        public static void RunAll(Action<BaseScript> cb)
+        public static void Clear()
+        {
+            _scripts.Clear();
+        }
+
+        public static void RemoveScripts(Type type)
+        {
+            foreach (var script in _scripts.Where(script => script.GetType() == type))
+            {
+                // drops its timers and coroutines as well
+                script._timersStopped = true;
+            }
+
+            _scripts.RemoveAll(script => script.GetType() == type);
+        }
+
+        // name is what the call shows up as in the profiler
+        public static void RunAll(string name, Action<BaseScript> cb)
         {
             var scripts = _scripts.ToArray();
 
             foreach (var script in scripts)
             {
+                var type = script.GetType();
+
+                // disabled by an earlier script in this loop
+                if (ScriptWatchdog.IsDisabled(type))
+                {
+                    continue;
+                }
+
+                var sample = ScriptProfiler.Begin();
+                ScriptWatchdog.Enter(type, name);
+
                 try
                 {
                     cb(script);
                 }
                 catch (Exception ex)
                 {
-                    Log.Write(LogLevel.Error, "Exception during RunAll call: {0}", ex.ToString());
+                    if (!ScriptWatchdog.HandleAbort(ex))
+                    {
+                        Log.Write(LogLevel.Error, "Exception during RunAll call: {0}", ex.ToString());
+                    }
+                }
+                finally
+                {
+                    ScriptWatchdog.Exit();
                 }
+
+                ScriptProfiler.End(type, name, sample);
             }
         }
     }
@@ -0,0 +1,287 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    internal sealed class ProfileEntry
+    {
+        public string Script;
+        public string Handler;
+        public Type ScriptType;
+
+        public long Calls;
+        public long TotalTicks;
+        public long MaxTicks;
+
+        // growth of the managed heap during the calls, there's no exact per-call allocation counter on this runtime
+        public long AllocatedBytes;
+        public int Collections;
+    }
+
+    internal struct ProfileSample
+    {
+        public long Timestamp;
+        public long Memory;
+        public int Collections;
+
+        // totals of the profiled calls nested in this one when it started
+        public long NestedTicks;
+        public long NestedMemory;
+        public int NestedCollections;
+    }
+
+    // call counts and timings of script handlers, controlled through the scriptprof server command; each entry only
+    // counts its own time, the handlers it causes (like the Tick and notify handlers run by RunFrame) have their own
+    public static class ScriptProfiler
+    {
+        private static bool _enabled;
+
+        // inclusive totals of the calls that ended so far, a call subtracts the part that ended while it ran
+        private static long _nestedTicks;
+        private static long _nestedMemory;
+        private static int _nestedCollections;
+
+        private static Dictionary<Type, Dictionary<string, ProfileEntry>> _entries = new Dictionary<Type, Dictionary<string, ProfileEntry>>();
+
+        private static string _dumpFile = "scriptprof.log";
+        private static long _dumpInterval;
+        private static long _nextDump;
+
+        public static bool Enabled
+        {
+            get
+            {
+                return _enabled;
+            }
+            set
+            {
+                _enabled = value;
+            }
+        }
+
+        internal static ProfileEntry GetEntry(Type script, string handler)
+        {
+            Dictionary<string, ProfileEntry> handlers;
+
+            if (!_entries.TryGetValue(script, out handlers))
+            {
+                handlers = new Dictionary<string, ProfileEntry>();
+                _entries[script] = handlers;
+            }
+
+            ProfileEntry entry;
+
+            if (!handlers.TryGetValue(handler, out entry))
+            {
+                entry = new ProfileEntry() { Script = script.Name, Handler = handler, ScriptType = script };
+                handlers[handler] = entry;
+            }
+
+            return entry;
+        }
+
+        // attributes a handler to the script that declared it, rather than to the closure class the compiler made for it
+        internal static ProfileEntry GetEntry(Delegate handler, string kind)
+        {
+            return GetEntry(GetScriptType(handler.Method.DeclaringType), kind + " " + handler.Method.Name);
+        }
+
+        internal static Type GetScriptType(Type type)
+        {
+            while (type.DeclaringType != null)
+            {
+                type = type.DeclaringType;
+            }
+
+            return type;
+        }
+
+        internal static ProfileSample Begin()
+        {
+            var sample = new ProfileSample();
+
+            if (_enabled)
+            {
+                sample.NestedTicks = _nestedTicks;
+                sample.NestedMemory = _nestedMemory;
+                sample.NestedCollections = _nestedCollections;
+                sample.Memory = GC.GetTotalMemory(false);
+                sample.Collections = GC.CollectionCount(0);
+                sample.Timestamp = Stopwatch.GetTimestamp();
+            }
+
+            return sample;
+        }
+
+        internal static void End(ProfileEntry entry, ProfileSample sample)
+        {
+            // not started, or profiling got enabled in the handler; handlers without an entry profile themselves
+            if (sample.Timestamp == 0 || entry == null)
+            {
+                return;
+            }
+
+            long ticks = Stopwatch.GetTimestamp() - sample.Timestamp;
+            long allocated = Math.Max(GC.GetTotalMemory(false) - sample.Memory, 0);
+            int collections = GC.CollectionCount(0) - sample.Collections;
+
+            // the caller's entry gets it all as nested
+            long ownTicks = ticks - (_nestedTicks - sample.NestedTicks);
+            long ownAllocated = allocated - (_nestedMemory - sample.NestedMemory);
+            int ownCollections = collections - (_nestedCollections - sample.NestedCollections);
+
+            _nestedTicks = sample.NestedTicks + ticks;
+            _nestedMemory = sample.NestedMemory + allocated;
+            _nestedCollections = sample.NestedCollections + collections;
+
+            entry.Calls++;
+            entry.TotalTicks += ownTicks;
+            entry.Collections += Math.Max(ownCollections, 0);
+
+            if (ownTicks > entry.MaxTicks)
+            {
+                entry.MaxTicks = ownTicks;
+            }
+
+            // a collection in between makes the heap shrink instead
+            if (ownAllocated > 0)
+            {
+                entry.AllocatedBytes += ownAllocated;
+            }
+        }
+
+        // the entry of a handler gets looked up on its first profiled call, so that registering one doesn't cost
+        // anything while profiling is off
+        internal static void End(ref ProfileEntry entry, Delegate handler, string kind, ProfileSample sample)
+        {
+            if (sample.Timestamp == 0)
+            {
+                return;
+            }
+
+            if (entry == null)
+            {
+                entry = GetEntry(handler, kind);
+            }
+
+            End(entry, sample);
+        }
+
+        internal static void End(Type script, string handler, ProfileSample sample)
+        {
+            if (sample.Timestamp != 0)
+            {
+                End(GetEntry(script, handler), sample);
+            }
+        }
+
+        public static void Reset()
+        {
+            foreach (var handlers in _entries.Values)
+            {
+                foreach (var entry in handlers.Values)
+                {
+                    entry.Calls = 0;
+                    entry.TotalTicks = 0;
+                    entry.MaxTicks = 0;
+                    entry.AllocatedBytes = 0;
+                    entry.Collections = 0;
+                }
+            }
+        }
+
+        internal static void RunFrame()
+        {
+            if (_dumpInterval == 0)
+            {
+                return;
+            }
+
+            long now = Stopwatch.GetTimestamp();
+
+            if (now >= _nextDump)
+            {
+                _nextDump = now + _dumpInterval;
+
+                try
+                {
+                    File.AppendAllText(_dumpFile, string.Format("-- {0}{1}{2}{1}", DateTime.Now, Environment.NewLine, string.Join(Environment.NewLine, GetReport())));
+                }
+                catch (Exception ex)
+                {
+                    Log.Write(LogLevel.Error, "Could not write the script profile to {0}: {1}", _dumpFile, ex.Message);
+                    _dumpInterval = 0;
+                }
+            }
+        }
+
+        // scriptprof [on|off|reset|dump <seconds> [file]]; without arguments the profile is printed
+        internal static void HandleCommand(string[] args)
+        {
+            var command = (args.Length > 1) ? args[1].ToLowerInvariant() : "";
+
+            switch (command)
+            {
+                case "on":
+                    _enabled = true;
+                    Log.Write(LogLevel.Info, "Script profiling enabled.");
+                    break;
+                case "off":
+                    _enabled = false;
+                    Log.Write(LogLevel.Info, "Script profiling disabled.");
+                    break;
+                case "reset":
+                    Reset();
+                    break;
+                case "dump":
+                    int seconds;
+
+                    if (args.Length < 3 || !int.TryParse(args[2], out seconds) || seconds < 0)
+                    {
+                        Log.Write(LogLevel.Info, "usage: scriptprof dump <seconds> [file], 0 seconds stops dumping");
+                        break;
+                    }
+
+                    if (args.Length > 3)
+                    {
+                        _dumpFile = args[3];
+                    }
+
+                    _dumpInterval = seconds * Stopwatch.Frequency;
+                    _nextDump = Stopwatch.GetTimestamp() + _dumpInterval;
+                    break;
+                default:
+                    foreach (var line in GetReport())
+                    {
+                        Log.Write(LogLevel.Info, line);
+                    }
+                    break;
+            }
+        }
+
+        private static IEnumerable<string> GetReport()
+        {
+            var entries = _entries.Values.SelectMany(handlers => handlers.Values).Where(entry => entry.Calls > 0).OrderByDescending(entry => entry.TotalTicks);
+            double msPerTick = 1000.0 / Stopwatch.Frequency;
+
+            yield return string.Format("{0,-24} {1,-40} {2,10} {3,12} {4,10} {5,10} {6,12} {7,6}", "script", "handler", "calls", "self ms", "avg ms", "max ms", "alloc KB", "gen0");
+
+            foreach (var entry in entries)
+            {
+                yield return string.Format("{0,-24} {1,-40} {2,10} {3,12:0.000} {4,10:0.000} {5,10:0.000} {6,12:0.0} {7,6}",
+                    entry.Script,
+                    entry.Handler,
+                    entry.Calls,
+                    entry.TotalTicks * msPerTick,
+                    entry.TotalTicks * msPerTick / entry.Calls,
+                    entry.MaxTicks * msPerTick,
+                    entry.AllocatedBytes / 1024.0,
+                    entry.Collections);
+            }
+        }
+    }
+}
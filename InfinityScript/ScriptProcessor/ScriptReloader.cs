@@ -0,0 +1,248 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    // with sv_scriptHotReload 1, watches the scripts directory and swaps the scripts of a changed assembly at the start
+    // of the next frame, without a map restart; the scripts of the other assemblies keep running with their state
+    internal static class ScriptReloader
+    {
+        private static FileSystemWatcher _watcher;
+
+        // filled by the watcher thread
+        private static object _changeLock = new object();
+        private static HashSet<string> _changedFiles = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+        private static DateTime _lastChange;
+        private static volatile bool _pending;
+
+        // times each file got queued again while it couldn't be read, so a file that stays locked isn't retried forever
+        private static Dictionary<string, int> _retries = new Dictionary<string, int>(StringComparer.OrdinalIgnoreCase);
+        private const int MaxRetries = 10;
+
+        static ScriptReloader()
+        {
+            SettleTime = 500;
+        }
+
+        // milliseconds without further changes before a file gets reloaded, as compilers write the file in steps
+        public static int SettleTime { get; set; }
+
+        public static bool Enabled
+        {
+            get
+            {
+                return _watcher != null;
+            }
+        }
+
+        // called before the scripts get loaded, as they get loaded from shadow copies with hot reload on
+        public static void Start()
+        {
+            bool enabled;
+
+            try
+            {
+                enabled = (Function.Call<int>("getDvarInt", "sv_scriptHotReload", 0) != 0);
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Warning, "Could not read sv_scriptHotReload: {0}", ex.Message);
+                enabled = false;
+            }
+
+            ScriptLoader.ShadowCopy = enabled;
+            Enable(enabled);
+        }
+
+        public static void Enable(bool enabled)
+        {
+            if (enabled == Enabled)
+            {
+                return;
+            }
+
+            if (!enabled)
+            {
+                _watcher.EnableRaisingEvents = false;
+                _watcher.Dispose();
+                _watcher = null;
+                return;
+            }
+
+            try
+            {
+                var watcher = new FileSystemWatcher(Path.GetFullPath("scripts"), "*.dll");
+                watcher.NotifyFilter = NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size;
+                watcher.Changed += (sender, e) => FileChanged(e.FullPath);
+                watcher.Created += (sender, e) => FileChanged(e.FullPath);
+                watcher.Deleted += (sender, e) => FileChanged(e.FullPath);
+                watcher.Renamed += (sender, e) =>
+                {
+                    FileChanged(e.OldFullPath);
+                    FileChanged(e.FullPath);
+                };
+                watcher.EnableRaisingEvents = true;
+
+                _watcher = watcher;
+            }
+            catch (Exception ex)
+            {
+                Log.Write(LogLevel.Warning, "Could not watch the scripts directory: {0}", ex.Message);
+            }
+        }
+
+        private static void FileChanged(string file)
+        {
+            lock (_changeLock)
+            {
+                _changedFiles.Add(file);
+                _lastChange = DateTime.UtcNow;
+            }
+
+            _pending = true;
+        }
+
+        // a frame boundary, so no script handler is running while their scripts get swapped
+        internal static void RunFrame()
+        {
+            if (!_pending)
+            {
+                return;
+            }
+
+            string[] files;
+
+            lock (_changeLock)
+            {
+                if ((DateTime.UtcNow - _lastChange).TotalMilliseconds < SettleTime)
+                {
+                    return;
+                }
+
+                files = _changedFiles.ToArray();
+
+                _changedFiles.Clear();
+                _pending = false;
+            }
+
+            foreach (var file in files)
+            {
+                if (ScriptLoader.IsScriptFile(file))
+                {
+                    Reload(file);
+                }
+            }
+        }
+
+        private static void Reload(string file)
+        {
+            List<BaseScript> scripts;
+
+            try
+            {
+                scripts = ScriptLoader.ReloadFile(file);
+            }
+            catch (FileLoadException ex)
+            {
+                // an IOException too, but one the file itself causes, like a version that can't be loaded
+                _retries.Remove(file);
+                Log.Write(LogLevel.Error, "Could not load {0}: {1}", file, ex.Message);
+                return;
+            }
+            catch (BadImageFormatException ex)
+            {
+                _retries.Remove(file);
+                Log.Write(LogLevel.Error, "{0} is not a valid assembly: {1}", file, ex.Message);
+                return;
+            }
+            catch (IOException ex)
+            {
+                int retries;
+                _retries.TryGetValue(file, out retries);
+
+                // still being written, or locked by the compiler; try again once it settled
+                if (retries < MaxRetries)
+                {
+                    _retries[file] = retries + 1;
+                    FileChanged(file);
+                    return;
+                }
+
+                _retries.Remove(file);
+                Log.Write(LogLevel.Error, "Gave up reloading {0} after {1} tries: {2}", file, retries + 1, ex.Message);
+                return;
+            }
+            catch (Exception ex)
+            {
+                _retries.Remove(file);
+                Log.Write(LogLevel.Error, "Error while reloading {0}: {1}", file, ex.ToString());
+                return;
+            }
+
+            _retries.Remove(file);
+
+            // the new scripts missed the start of the game and the players joining
+            var snapshot = PlayerSnapshot.Current;
+
+            foreach (var script in scripts)
+            {
+                try
+                {
+                    script.OnStartGameType();
+
+                    for (int i = 0; i < PlayerSnapshot.MaxClients; i++)
+                    {
+                        if (snapshot[i].IsConnected)
+                        {
+                            script.AddConnectedPlayer(snapshot[i].Entity);
+                        }
+                    }
+                }
+                catch (Exception ex)
+                {
+                    Log.Write(LogLevel.Error, "An error occurred while starting the reloaded script {0}: {1}", script.GetType().Name, ex.ToString());
+                }
+            }
+        }
+
+        // changes that came in before the scripts got loaded again are in the new scripts already
+        internal static void Clear()
+        {
+            lock (_changeLock)
+            {
+                _changedFiles.Clear();
+                _pending = false;
+            }
+
+            _retries.Clear();
+        }
+
+        internal static void HandleCommand(string[] args)
+        {
+            if (args.Length < 2)
+            {
+                Log.Write(LogLevel.Info, "hot reload is {0}", (Enabled) ? "on" : "off");
+                Log.Write(LogLevel.Info, "usage: scriptreload [on|off|<file>]");
+                return;
+            }
+
+            switch (args[1].ToLowerInvariant())
+            {
+                case "on":
+                    // files loaded without shadow copies stay locked until the next map on Windows
+                    ScriptLoader.ShadowCopy = true;
+                    Enable(true);
+                    break;
+                case "off":
+                    Enable(false);
+                    break;
+                default:
+                    Reload(Path.Combine("scripts", args[1]));
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace InfinityScript
+{
+    public sealed class ScriptTimer
+    {
+        internal Notifiable owner;
+        internal Delegate function;
+        internal Func<Notifiable, bool> invoker;
+        internal int triggerTime;
+        internal int interval;
+
+        // tie breaker between timers due at the same time, keeps them in the order they got scheduled
+        internal long sequence;
+
+        // position in the scheduler heap, -1 if not in there
+        internal int heapIndex = -1;
+
+        internal bool active;
+
+        // looked up on the first profiled run
+        internal ProfileEntry profile;
+
+        internal ScriptTimer(Notifiable owner, Delegate function, int triggerTime, int interval)
+        {
+            this.owner = owner;
+            this.function = function;
+            this.invoker = DelegateInvoker.CreateTimerInvoker(function);
+            this.triggerTime = triggerTime;
+            this.interval = interval;
+        }
+
+        // a one-shot timer that gets scheduled again by its owner, which times and profiles it itself
+        internal ScriptTimer(Notifiable owner, Func<Notifiable, bool> invoker)
+        {
+            this.owner = owner;
+            this.invoker = invoker;
+            this.interval = -1;
+        }
+
+        internal string Kind
+        {
+            get
+            {
+                return (interval == -1) ? "AfterDelay" : "OnInterval";
+            }
+        }
+
+        public bool IsActive
+        {
+            get
+            {
+                return active;
+            }
+        }
+
+        public void Cancel()
+        {
+            TimerScheduler.Cancel(this);
+        }
+    }
+}
@@ -0,0 +1,246 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+using System.Threading;
+
+namespace InfinityScript
+{
+    // thrown from the next game call of a handler that ran past the watchdog's AbortTime
+    internal sealed class ScriptAbortedException : Exception
+    {
+        public ScriptAbortedException(string message)
+            : base(message)
+        {
+        }
+    }
+
+    // times the script handlers the game thread runs; slow ones get logged, and one running past AbortTime gets
+    // stopped and its script disabled, instead of hanging the server
+    internal static class ScriptWatchdog
+    {
+        private static Thread _thread;
+
+        // guards the handler state between the game thread and the watchdog thread
+        private static object _abortLock = new object();
+
+        // only the outermost handler is timed, as handlers can cause notifies that run other handlers
+        private static int _depth;
+        private static long _startTime;
+        private static Type _script;
+        private static string _handlerKind;
+        private static MemberInfo _handlerMember;
+
+        // the handler gets stopped at its next game call, where the call state is consistent; one that never calls
+        // into the game again can't be stopped, as aborting the game thread isn't safe (nor supported everywhere)
+        private static volatile bool _abortRequested;
+        private static Type _abortScript;
+        private static string _abortHandlerKind;
+        private static MemberInfo _abortHandlerMember;
+
+        private static HashSet<Type> _disabled = new HashSet<Type>();
+
+        static ScriptWatchdog()
+        {
+            WarnTime = 100;
+            AbortTime = 10000;
+        }
+
+        // milliseconds after which a handler gets logged as slow, 0 to not log
+        public static int WarnTime { get; set; }
+
+        // milliseconds after which a handler gets aborted, 0 to let it run
+        public static int AbortTime { get; set; }
+
+        public static void Start()
+        {
+            if (_thread == null)
+            {
+                _thread = new Thread(WatchdogThread);
+                _thread.IsBackground = true;
+                _thread.Name = "ScriptWatchdog";
+                _thread.Start();
+            }
+        }
+
+        public static void Enter(Type script, string handler)
+        {
+            Enter(script, handler, null);
+        }
+
+        // handlers are named by their kind and method, which only get put together when the handler gets logged
+        public static void Enter(Delegate handler, string kind)
+        {
+            Enter(ScriptProfiler.GetScriptType(handler.Method.DeclaringType), kind, handler.Method);
+        }
+
+        public static void Enter(Type script, string kind, MemberInfo member)
+        {
+            if (_depth++ > 0)
+            {
+                return;
+            }
+
+            _script = script;
+            _handlerKind = kind;
+            _handlerMember = member;
+
+            lock (_abortLock)
+            {
+                _startTime = Stopwatch.GetTimestamp();
+            }
+        }
+
+        public static void Exit()
+        {
+            if (_depth == 0 || --_depth > 0)
+            {
+                return;
+            }
+
+            long startTime;
+
+            lock (_abortLock)
+            {
+                startTime = _startTime;
+                _startTime = 0;
+
+                // the abort may have left through a path that doesn't call HandleAbort
+                _abortRequested = false;
+            }
+
+            long milliseconds = ((Stopwatch.GetTimestamp() - startTime) * 1000) / Stopwatch.Frequency;
+
+            if (WarnTime > 0 && milliseconds >= WarnTime)
+            {
+                Log.Write(LogLevel.Warning, "Script {0} took {1} ms in {2}.", _script.Name, milliseconds, GetHandlerName(_handlerKind, _handlerMember));
+            }
+        }
+
+        // called before every game call from a handler
+        internal static void CheckAbort()
+        {
+            if (_abortRequested && _depth > 0)
+            {
+                throw new ScriptAbortedException("The script ran for longer than " + AbortTime + " ms.");
+            }
+        }
+
+        // to be called from the catch around a handler; true if the exception was the watchdog stopping it
+        public static bool HandleAbort(Exception ex)
+        {
+            if (!(ex is ScriptAbortedException) || !_abortRequested)
+            {
+                return false;
+            }
+
+            Function.ResetCallState();
+
+            // let it unwind up to the outermost handler, which is the one that got stuck; the next game call of that
+            // one throws again
+            if (_depth > 1)
+            {
+                return true;
+            }
+
+            lock (_abortLock)
+            {
+                _abortRequested = false;
+            }
+
+            Log.Write(LogLevel.Error, "Script {0} ran {1} for more than {2} ms, and has been disabled: {3}", _abortScript.Name, GetHandlerName(_abortHandlerKind, _abortHandlerMember), AbortTime, ex.StackTrace);
+
+            Disable(_abortScript);
+
+            return true;
+        }
+
+        private static string GetHandlerName(string kind, MemberInfo member)
+        {
+            return (member == null) ? kind : kind + " " + member.Name;
+        }
+
+        public static bool IsDisabled(Type script)
+        {
+            return _disabled.Count > 0 && script != null && _disabled.Contains(script);
+        }
+
+        // for delegates that aren't wrapped in a handler with a profile entry
+        public static bool IsDisabled(Delegate handler)
+        {
+            return _disabled.Count > 0 && handler.Method.DeclaringType != null && _disabled.Contains(ScriptProfiler.GetScriptType(handler.Method.DeclaringType));
+        }
+
+        // stops a script from running any more of its handlers until the scripts get loaded again
+        public static void Disable(Type script)
+        {
+            _disabled.Add(script);
+
+            ScriptProcessor.RemoveScripts(script);
+        }
+
+        public static void Clear()
+        {
+            _disabled.Clear();
+        }
+
+        private static void WatchdogThread()
+        {
+            while (true)
+            {
+                Thread.Sleep(50);
+
+                if (AbortTime <= 0)
+                {
+                    continue;
+                }
+
+                lock (_abortLock)
+                {
+                    if (_startTime == 0 || _abortRequested)
+                    {
+                        continue;
+                    }
+
+                    long milliseconds = ((Stopwatch.GetTimestamp() - _startTime) * 1000) / Stopwatch.Frequency;
+
+                    if (milliseconds >= AbortTime)
+                    {
+                        _abortScript = _script;
+                        _abortHandlerKind = _handlerKind;
+                        _abortHandlerMember = _handlerMember;
+                        _abortRequested = true;
+                    }
+                }
+            }
+        }
+
+        // scriptbudget [frame|warn|abort <ms>]; without arguments the current settings are printed
+        internal static void HandleCommand(string[] args)
+        {
+            int milliseconds;
+
+            if (args.Length < 3 || !int.TryParse(args[2], out milliseconds) || milliseconds < 0)
+            {
+                Log.Write(LogLevel.Info, "frame budget {0} ms, warn after {1} ms, abort after {2} ms", FrameBudget.Milliseconds, WarnTime, AbortTime);
+                Log.Write(LogLevel.Info, "usage: scriptbudget [frame|warn|abort <ms>], 0 ms turns it off");
+                return;
+            }
+
+            switch (args[1].ToLowerInvariant())
+            {
+                case "frame":
+                    FrameBudget.Milliseconds = milliseconds;
+                    break;
+                case "warn":
+                    WarnTime = milliseconds;
+                    break;
+                case "abort":
+                    AbortTime = milliseconds;
+                    break;
+            }
+        }
+    }
+}
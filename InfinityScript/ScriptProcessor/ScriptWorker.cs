@@ -0,0 +1,244 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Text;
+using System.Threading;
+
+namespace InfinityScript
+{
+    // runs slow script work (web requests, databases, file reads) off the game thread, and hands the results back to it
+    public static class ScriptWorker
+    {
+        private struct Callback
+        {
+            public int generation;
+            public Action action;
+
+            // what the script passed in, for the profiler and errors
+            public Delegate source;
+        }
+
+        private static BlockingCollection<Action> _work;
+        private static Thread[] _threads;
+        private static object _startLock = new object();
+
+        private static ConcurrentQueue<Callback> _callbacks = new ConcurrentQueue<Callback>();
+
+        // callbacks queued before the scripts got reloaded belong to scripts that are gone
+        private static int _generation;
+
+        [ThreadStatic]
+        private static bool _isWorker;
+
+        private static Stopwatch _frameTime = new Stopwatch();
+
+        static ScriptWorker()
+        {
+            FrameBudget = 2.0;
+        }
+
+        // milliseconds of callbacks run per frame, the others wait for the next frame
+        public static double FrameBudget { get; set; }
+
+        // whether this is one of the worker threads, which can't use anything that talks to the game
+        public static bool IsWorkerThread
+        {
+            get
+            {
+                return _isWorker;
+            }
+        }
+
+        public static void Run(Action work)
+        {
+            Run(work, null, null);
+        }
+
+        // runs work on a worker thread, then callback (or error, if it threw) on the game thread
+        public static void Run(Action work, Action callback, Action<Exception> error)
+        {
+            if (work == null)
+            {
+                throw new ArgumentNullException("work");
+            }
+
+            Queue<object>(() =>
+            {
+                work();
+                return null;
+            }, work, (callback == null) ? null : new Action<object>(result => callback()), callback, error);
+        }
+
+        public static void Run<TResult>(Func<TResult> work, Action<TResult> callback)
+        {
+            Run(work, callback, null);
+        }
+
+        public static void Run<TResult>(Func<TResult> work, Action<TResult> callback, Action<Exception> error)
+        {
+            if (work == null)
+            {
+                throw new ArgumentNullException("work");
+            }
+
+            Queue(work, work, callback, callback, error);
+        }
+
+        // the sources are the delegates the script passed in, which the wrappers above hide
+        private static void Queue<TResult>(Func<TResult> work, Delegate workSource, Action<TResult> callback, Delegate callbackSource, Action<Exception> error)
+        {
+            Start();
+
+            int generation = _generation;
+
+            _work.Add(() =>
+            {
+                TResult result;
+
+                try
+                {
+                    result = work();
+                }
+                catch (Exception ex)
+                {
+                    if (error != null)
+                    {
+                        Post(generation, () => error(ex), error);
+                    }
+                    else
+                    {
+                        Post(generation, () => Log.Write(LogLevel.Error, "Exception in worker {0}: {1}", workSource.Method.Name, ex.ToString()), workSource);
+                    }
+
+                    return;
+                }
+
+                if (callback != null)
+                {
+                    Post(generation, () => callback(result), callbackSource);
+                }
+            });
+        }
+
+        // queues an action to run on the game thread at the end of the current or next frame; safe to call from any thread
+        public static void RunOnMainThread(Action action)
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+
+            Post(_generation, action, action);
+        }
+
+        internal static void AssertMainThread()
+        {
+            if (_isWorker)
+            {
+                throw new InvalidOperationException("The game can't be accessed from a worker thread; pass a callback to ScriptWorker.Run instead.");
+            }
+        }
+
+        private static void Post(int generation, Action action, Delegate source)
+        {
+            _callbacks.Enqueue(new Callback() { generation = generation, action = action, source = source });
+        }
+
+        private static void Start()
+        {
+            if (_threads != null)
+            {
+                return;
+            }
+
+            lock (_startLock)
+            {
+                if (_threads != null)
+                {
+                    return;
+                }
+
+                // the game thread keeps one core to itself
+                var numThreads = Math.Min(Math.Max(Environment.ProcessorCount - 1, 1), 4);
+                var threads = new Thread[numThreads];
+
+                _work = new BlockingCollection<Action>();
+
+                for (int i = 0; i < threads.Length; i++)
+                {
+                    threads[i] = new Thread(WorkerThread);
+                    threads[i].IsBackground = true;
+                    threads[i].Name = "ScriptWorker " + i;
+                    threads[i].Start();
+                }
+
+                _threads = threads;
+            }
+        }
+
+        private static void WorkerThread()
+        {
+            _isWorker = true;
+
+            foreach (var work in _work.GetConsumingEnumerable())
+            {
+                work();
+            }
+        }
+
+        internal static void RunFrame()
+        {
+            if (_callbacks.IsEmpty)
+            {
+                return;
+            }
+
+            _frameTime.Reset();
+            _frameTime.Start();
+
+            Callback callback;
+
+            // always make some progress, even if the callbacks take longer than the budget; callbacks of scripts that
+            // got disabled or reloaded since are dropped
+            while (_callbacks.TryDequeue(out callback))
+            {
+                if (callback.generation == _generation && !ScriptWatchdog.IsDisabled(callback.source))
+                {
+                    var sample = ScriptProfiler.Begin();
+
+                    try
+                    {
+                        callback.action();
+                    }
+                    catch (Exception ex)
+                    {
+                        Log.Write(LogLevel.Error, "Exception in worker callback {0}: {1}", callback.source.Method.Name, ex.ToString());
+                    }
+
+                    if (sample.Timestamp != 0)
+                    {
+                        ScriptProfiler.End(ScriptProfiler.GetEntry(callback.source, "Callback"), sample);
+                    }
+                }
+
+                if (_frameTime.Elapsed.TotalMilliseconds >= FrameBudget)
+                {
+                    break;
+                }
+            }
+        }
+
+        internal static void Clear()
+        {
+            Interlocked.Increment(ref _generation);
+
+            Callback callback;
+
+            while (_callbacks.TryDequeue(out callback))
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,263 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+
+namespace InfinityScript
+{
+    // a single min-heap of all script and entity timers, ordered by trigger time
+    internal static class TimerScheduler
+    {
+        private static ScriptTimer[] _heap = new ScriptTimer[64];
+        private static int _count;
+        private static long _nextSequence;
+
+        private static List<ScriptTimer> _dueTimers = new List<ScriptTimer>();
+
+        public static int CurrentTime { get; private set; }
+
+        public static ScriptTimer Add(Notifiable owner, Delegate function, int triggerTime, int interval)
+        {
+            var timer = new ScriptTimer(owner, function, triggerTime, interval);
+
+            Schedule(timer);
+
+            return timer;
+        }
+
+        public static void Cancel(ScriptTimer timer)
+        {
+            timer.active = false;
+
+            if (timer.heapIndex >= 0)
+            {
+                RemoveAt(timer.heapIndex);
+            }
+        }
+
+        internal static void Reschedule(ScriptTimer timer, int triggerTime)
+        {
+            if (timer.heapIndex >= 0)
+            {
+                RemoveAt(timer.heapIndex);
+            }
+
+            timer.triggerTime = triggerTime;
+            Schedule(timer);
+        }
+
+        // drops all timers, for when the scripts owning them go away; the clock starts over with the next map, like it
+        // does in a new script domain, so timers added before its first frame aren't based on the previous map's time
+        public static void Clear()
+        {
+            for (int i = 0; i < _count; i++)
+            {
+                _heap[i].active = false;
+                _heap[i].heapIndex = -1;
+                _heap[i] = null;
+            }
+
+            _count = 0;
+            CurrentTime = 0;
+        }
+
+        public static void RunFrame()
+        {
+            // one time read for all the timers
+            Function.SetEntRef(-1);
+            CurrentTime = Function.Call<int>("getTime");
+
+            // take the due timers out first, so that timers (re)scheduled by the handlers wait for the next frame
+            while (_count > 0 && _heap[0].triggerTime <= CurrentTime)
+            {
+                _dueTimers.Add(_heap[0]);
+                RemoveAt(0);
+            }
+
+            for (int i = 0; i < _dueTimers.Count; i++)
+            {
+                var timer = _dueTimers[i];
+
+                // cancelled by an earlier handler, owned by an entity that went away, or by a disabled script
+                if (!timer.active || timer.owner._timersStopped || (timer.function != null && ScriptWatchdog.IsDisabled(timer.function)))
+                {
+                    timer.active = false;
+                    continue;
+                }
+
+                // out of time for this frame, the rest are still due and go first next frame
+                if (i > 0 && FrameBudget.Exhausted)
+                {
+                    Schedule(timer);
+                    continue;
+                }
+
+                var sample = ScriptProfiler.Begin();
+
+                if (timer.function != null)
+                {
+                    ScriptWatchdog.Enter(timer.function, timer.Kind);
+                }
+
+                try
+                {
+                    if (!timer.invoker(timer.owner) || timer.interval == -1)
+                    {
+                        // unless the handler scheduled it again
+                        if (timer.heapIndex == -1)
+                        {
+                            timer.active = false;
+                        }
+
+                        continue;
+                    }
+
+                    // the handler may have cancelled its own timer
+                    if (timer.active)
+                    {
+                        timer.triggerTime = CurrentTime + timer.interval;
+                        Schedule(timer);
+                    }
+                }
+                catch (Exception ex)
+                {
+                    if (!ScriptWatchdog.HandleAbort(ex))
+                    {
+                        Log.Write(LogLevel.Error, "Error during handling timer in script {0}: {1}", timer.owner.GetType().Name, (ex is TargetInvocationException) ? ex.InnerException.ToString() : ex.ToString());
+                    }
+
+                    timer.active = false;
+                }
+                finally
+                {
+                    if (timer.function != null)
+                    {
+                        ScriptWatchdog.Exit();
+                        ScriptProfiler.End(ref timer.profile, timer.function, timer.Kind, sample);
+                    }
+                }
+            }
+
+            _dueTimers.Clear();
+        }
+
+        // handlers schedule and cancel timers, so the heap changes are in finally blocks, which a thread abort (like the
+        // one of a domain unload) waits for; an abort halfway would leave the heap out of order
+        private static void Schedule(ScriptTimer timer)
+        {
+            try
+            {
+            }
+            finally
+            {
+                if (_count == _heap.Length)
+                {
+                    Array.Resize(ref _heap, _heap.Length * 2);
+                }
+
+                timer.active = true;
+                timer.sequence = _nextSequence++;
+
+                _heap[_count] = timer;
+                timer.heapIndex = _count;
+                _count++;
+
+                SiftUp(timer.heapIndex);
+            }
+        }
+
+        private static void RemoveAt(int index)
+        {
+            try
+            {
+            }
+            finally
+            {
+                var timer = _heap[index];
+                timer.heapIndex = -1;
+
+                _count--;
+
+                if (index != _count)
+                {
+                    // move the last timer in the hole, then restore the heap order around it
+                    _heap[index] = _heap[_count];
+                    _heap[index].heapIndex = index;
+                    _heap[_count] = null;
+
+                    SiftUp(index);
+                    SiftDown(_heap[index].heapIndex);
+                }
+                else
+                {
+                    _heap[_count] = null;
+                }
+            }
+        }
+
+        private static bool Before(ScriptTimer a, ScriptTimer b)
+        {
+            if (a.triggerTime != b.triggerTime)
+            {
+                return a.triggerTime < b.triggerTime;
+            }
+
+            return a.sequence < b.sequence;
+        }
+
+        private static void SiftUp(int index)
+        {
+            var timer = _heap[index];
+
+            while (index > 0)
+            {
+                int parent = (index - 1) / 2;
+
+                if (!Before(timer, _heap[parent]))
+                {
+                    break;
+                }
+
+                _heap[index] = _heap[parent];
+                _heap[index].heapIndex = index;
+                index = parent;
+            }
+
+            _heap[index] = timer;
+            timer.heapIndex = index;
+        }
+
+        private static void SiftDown(int index)
+        {
+            var timer = _heap[index];
+
+            while (true)
+            {
+                int child = (index * 2) + 1;
+
+                if (child >= _count)
+                {
+                    break;
+                }
+
+                if (child + 1 < _count && Before(_heap[child + 1], _heap[child]))
+                {
+                    child++;
+                }
+
+                if (!Before(_heap[child], timer))
+                {
+                    break;
+                }
+
+                _heap[index] = _heap[child];
+                _heap[index].heapIndex = index;
+                index = child;
+            }
+
+            _heap[index] = timer;
+            timer.heapIndex = index;
+        }
+    }
+}
@@ -0,0 +1,312 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading;
+
+namespace InfinityScript
+{
+    public enum GameLogFormat
+    {
+        // the classic games_mp.log lines, like K;guid;num;team;name;...
+        Text,
+        // one JSON object per line, with named fields
+        Json
+    }
+
+    // a game log event; the fields are formatted on the writer thread, not on the game thread
+    internal struct GameEvent
+    {
+        public TimeSpan time;
+
+        // null for free text lines, which have the text as only field
+        public string type;
+        public object[] fields;
+    }
+
+    // queues game log events and writes them in batches from a background thread, rotating the file when needed
+    internal sealed class GameEventWriter
+    {
+        private static readonly Dictionary<string, string[]> _fieldNames = new Dictionary<string, string[]>()
+        {
+            { "J", new[] { "guid", "num", "name" } },
+            { "Q", new[] { "guid", "num", "name" } },
+            { "D", new[] { "guid", "num", "team", "name", "aguid", "anum", "ateam", "aname", "weapon", "damage", "mod", "hitloc" } },
+            { "K", new[] { "guid", "num", "team", "name", "aguid", "anum", "ateam", "aname", "weapon", "damage", "mod", "hitloc" } },
+            { "say", new[] { "guid", "num", "name", "message" } }
+        };
+
+        private string _fileName;
+        private GameLogFormat _format;
+        private StreamWriter _writer;
+        private DateTime _openTime;
+        private object _writeLock = new object();
+
+        private ConcurrentQueue<GameEvent> _queue = new ConcurrentQueue<GameEvent>();
+        private Thread _thread;
+        private volatile bool _closed;
+
+        // kept to unsubscribe on Close, as a writer is made for every map while the domain stays
+        private EventHandler _closeHandler;
+
+        private StringBuilder _line = new StringBuilder();
+
+        // milliseconds between writes of the queued events
+        public int FlushInterval { get; set; }
+
+        // the file gets rotated once it's larger than this, 0 to not rotate on size
+        public long MaxFileSize { get; set; }
+
+        // the file gets rotated once it's been written to for this long, TimeSpan.Zero to not rotate on time
+        public TimeSpan MaxFileAge { get; set; }
+
+        public GameEventWriter(string fileName, GameLogFormat format)
+        {
+            _fileName = fileName;
+            _format = format;
+
+            FlushInterval = 1000;
+
+            Open();
+
+            _thread = new Thread(WriterThread);
+            _thread.IsBackground = true;
+            _thread.Name = "GameEventWriter";
+            _thread.Start();
+
+            _closeHandler = (sender, e) => Close();
+            AppDomain.CurrentDomain.DomainUnload += _closeHandler;
+            AppDomain.CurrentDomain.ProcessExit += _closeHandler;
+        }
+
+        public void Write(GameEvent gameEvent)
+        {
+            _queue.Enqueue(gameEvent);
+        }
+
+        public void Close()
+        {
+            AppDomain.CurrentDomain.DomainUnload -= _closeHandler;
+            AppDomain.CurrentDomain.ProcessExit -= _closeHandler;
+
+            WriteQueued();
+
+            _closed = true;
+
+            lock (_writeLock)
+            {
+                if (_writer != null)
+                {
+                    _writer.Close();
+                    _writer = null;
+                }
+            }
+        }
+
+        private void Open()
+        {
+            var file = File.Open(_fileName, FileMode.Append, FileAccess.Write, FileShare.ReadWrite);
+
+            _writer = new StreamWriter(file);
+            _openTime = DateTime.Now;
+        }
+
+        private void WriterThread()
+        {
+            while (!_closed)
+            {
+                Thread.Sleep(Math.Max(FlushInterval, 1));
+
+                try
+                {
+                    WriteQueued();
+                }
+                catch (IOException)
+                {
+                    // try again with the next batch
+                }
+                catch (Exception)
+                {
+                    // an exception here would take the server down, drop the batch instead
+                }
+            }
+        }
+
+        private void WriteQueued()
+        {
+            lock (_writeLock)
+            {
+                if (_writer == null || _queue.IsEmpty)
+                {
+                    return;
+                }
+
+                GameEvent gameEvent;
+
+                while (_queue.TryDequeue(out gameEvent))
+                {
+                    _line.Length = 0;
+
+                    if (_format == GameLogFormat.Json)
+                    {
+                        FormatJson(gameEvent);
+                    }
+                    else
+                    {
+                        FormatText(gameEvent);
+                    }
+
+                    _writer.WriteLine(_line.ToString());
+                }
+
+                _writer.Flush();
+
+                if ((MaxFileSize > 0 && _writer.BaseStream.Length >= MaxFileSize) || (MaxFileAge > TimeSpan.Zero && DateTime.Now - _openTime >= MaxFileAge))
+                {
+                    Rotate();
+                }
+            }
+        }
+
+        // rotated files get the time they were rotated at appended, e.g. games_mp.log.20130102-150405
+        private void Rotate()
+        {
+            _writer.Close();
+            _writer = null;
+
+            try
+            {
+                File.Move(_fileName, _fileName + "." + DateTime.Now.ToString("yyyyMMdd-HHmmss", CultureInfo.InvariantCulture));
+            }
+            catch (IOException)
+            {
+                // keep writing to the same file instead
+            }
+            catch (UnauthorizedAccessException)
+            {
+            }
+
+            try
+            {
+                Open();
+            }
+            catch (IOException)
+            {
+                _writer = null;
+            }
+            catch (UnauthorizedAccessException)
+            {
+                _writer = null;
+            }
+        }
+
+        private void FormatText(GameEvent gameEvent)
+        {
+            var secs = (int)gameEvent.time.TotalSeconds;
+            var time = string.Format("{0}:{1}", secs / 60, (secs % 60).ToString().PadLeft(2, '0'));
+
+            _line.Append(time.PadLeft(6, ' '));
+            _line.Append(' ');
+
+            if (gameEvent.type != null)
+            {
+                _line.Append(gameEvent.type);
+                _line.Append(';');
+            }
+
+            for (int i = 0; i < gameEvent.fields.Length; i++)
+            {
+                if (i > 0)
+                {
+                    _line.Append(';');
+                }
+
+                _line.Append(Convert.ToString(gameEvent.fields[i], CultureInfo.InvariantCulture));
+            }
+        }
+
+        private void FormatJson(GameEvent gameEvent)
+        {
+            _line.Append("{\"t\":");
+            _line.Append(gameEvent.time.TotalSeconds.ToString("0.###", CultureInfo.InvariantCulture));
+
+            string[] names;
+
+            if (gameEvent.type == null || !_fieldNames.TryGetValue(gameEvent.type, out names) || names.Length != gameEvent.fields.Length)
+            {
+                _line.Append(",\"ev\":");
+                AppendJsonString((gameEvent.type == null) ? "text" : gameEvent.type);
+
+                _line.Append(",\"text\":");
+                AppendJsonString(string.Join(";", gameEvent.fields.Select(field => Convert.ToString(field, CultureInfo.InvariantCulture))));
+            }
+            else
+            {
+                _line.Append(",\"ev\":");
+                AppendJsonString(gameEvent.type);
+
+                for (int i = 0; i < names.Length; i++)
+                {
+                    _line.Append(",\"");
+                    _line.Append(names[i]);
+                    _line.Append("\":");
+
+                    var field = gameEvent.fields[i];
+
+                    if (field is int)
+                    {
+                        _line.Append(((int)field).ToString(CultureInfo.InvariantCulture));
+                    }
+                    else
+                    {
+                        AppendJsonString(Convert.ToString(field, CultureInfo.InvariantCulture));
+                    }
+                }
+            }
+
+            _line.Append('}');
+        }
+
+        private void AppendJsonString(string value)
+        {
+            _line.Append('"');
+
+            foreach (var c in value)
+            {
+                switch (c)
+                {
+                    case '"':
+                        _line.Append("\\\"");
+                        break;
+                    case '\\':
+                        _line.Append("\\\\");
+                        break;
+                    case '\n':
+                        _line.Append("\\n");
+                        break;
+                    case '\r':
+                        _line.Append("\\r");
+                        break;
+                    case '\t':
+                        _line.Append("\\t");
+                        break;
+                    default:
+                        if (c < 0x20)
+                        {
+                            _line.AppendFormat("\\u{0:x4}", (int)c);
+                        }
+                        else
+                        {
+                            _line.Append(c);
+                        }
+                        break;
+                }
+            }
+
+            _line.Append('"');
+        }
+    }
+}
@@ -11,8 +11,7 @@ namespace InfinityScript
     {
         private string _fileName;
 
-        private Stream _file;
-        private static StreamWriter _writer;
+        private static GameEventWriter _writer;
 
         private static DateTime _startTime;
 
@@ -20,8 +19,18 @@ namespace InfinityScript
         {
             _fileName = "scripts/" + Call<string>("getDvar", "g_log", "games_mp.log").Replace("/", "").Replace("\\", "");
 
-            _file = File.Open(_fileName, FileMode.Append, FileAccess.Write, FileShare.ReadWrite);
-            _writer = new StreamWriter(_file);
+            // g_logFormat json writes the events as NDJSON instead of the classic lines
+            var format = (Call<string>("getDvar", "g_logFormat", "text").ToLowerInvariant() == "json") ? GameLogFormat.Json : GameLogFormat.Text;
+
+            // the script domain is kept across map changes, so a previous map's writer may still be open
+            if (_writer != null)
+            {
+                _writer.Close();
+            }
+
+            _writer = new GameEventWriter(_fileName, format);
+            _writer.MaxFileSize = Call<int>("getDvarInt", "g_logMaxSize", 0) * 1024L; // in KB
+            _writer.MaxFileAge = TimeSpan.FromMinutes(Call<int>("getDvarInt", "g_logRotateTime", 0));
 
             _startTime = DateTime.Now;
 
@@ -33,22 +42,22 @@ namespace InfinityScript
 
         void GameLog_PlayerConnected(Entity obj)
         {
-            Write("J;{0};{1};{2}", obj.Call<string>("getGuid"), obj.EntRef, obj.GetField<string>("name"));
+            WriteEvent("J", obj.Call<string>("getGuid"), obj.EntRef, obj.GetField<string>("name"));
         }
 
         public override void OnPlayerDisconnect(Entity obj)
         {
-            Write("Q;{0};{1};{2}", obj.Call<string>("getGuid"), obj.EntRef, obj.GetField<string>("name"));
+            WriteEvent("Q", obj.Call<string>("getGuid"), obj.EntRef, obj.GetField<string>("name"));
         }
 
         public override void OnPlayerDamage(Entity player, Entity inflictor, Entity attacker, int damage, int dFlags, string mod, string weapon, Vector3 point, Vector3 dir, string hitLoc)
         {
-            Write("D;{0};{1};{2};{3};{4};{5}", GetDamageDetails(player), GetDamageDetails(attacker), weapon, damage, mod, hitLoc);
+            WriteDamageEvent("D", player, attacker, weapon, damage, mod, hitLoc);
         }
 
         public override void OnPlayerKilled(Entity player, Entity inflictor, Entity attacker, int damage, string mod, string weapon, Vector3 dir, string hitLoc)
         {
-            Write("K;{0};{1};{2};{3};{4};{5}", GetDamageDetails(player), GetDamageDetails(attacker), weapon, damage, mod, hitLoc);
+            WriteDamageEvent("K", player, attacker, weapon, damage, mod, hitLoc);
         }
 
         public override void OnSay(Entity player, string name, string message)
@@ -58,7 +67,7 @@ namespace InfinityScript
                 message = message.Substring(1);
             }
 
-            Write("say;{0};{1};{2};{3}", player.Call<string>("getGuid"), player.EntRef, name, message);
+            WriteEvent("say", player.Call<string>("getGuid"), player.EntRef, name, message);
         }
 
         public override void OnExitLevel()
@@ -66,29 +75,47 @@ namespace InfinityScript
             Write("ExitLevel: executed");
         }
 
-        private string GetDamageDetails(Entity player)
+        private void WriteDamageEvent(string type, Entity player, Entity attacker, string weapon, int damage, string mod, string hitLoc)
+        {
+            var fields = new object[12];
+
+            GetDamageDetails(player, fields, 0);
+            GetDamageDetails(attacker, fields, 4);
+
+            fields[8] = weapon;
+            fields[9] = damage;
+            fields[10] = mod;
+            fields[11] = hitLoc;
+
+            _writer.Write(new GameEvent() { time = DateTime.Now - _startTime, type = type, fields = fields });
+        }
+
+        private void GetDamageDetails(Entity player, object[] fields, int offset)
         {
             if (player == null || !player.IsPlayer)
             {
-                return ";-1;world;world";
+                fields[offset] = "";
+                fields[offset + 1] = -1;
+                fields[offset + 2] = "world";
+                fields[offset + 3] = "world";
+                return;
             }
 
-            return string.Format("{0};{1};{2};{3}", player.Call<string>("getGuid"), player.EntRef, player.GetField<string>("sessionteam"), player.GetField<string>("name"));
+            fields[offset] = player.Call<string>("getGuid");
+            fields[offset + 1] = player.EntRef;
+            fields[offset + 2] = player.GetField<string>("sessionteam");
+            fields[offset + 3] = player.GetField<string>("name");
         }
 
-        public static void Write(string format, params object[] args)
+        // the fields are only turned into text on the writer thread
+        private static void WriteEvent(string type, params object[] fields)
         {
-            _writer.Write(FormatTime(DateTime.Now - _startTime));
-            _writer.Write(" ");
-            _writer.WriteLine(string.Format(format, args));
-            _writer.Flush();
+            _writer.Write(new GameEvent() { time = DateTime.Now - _startTime, type = type, fields = fields });
         }
 
-        private static string FormatTime(TimeSpan duration)
+        public static void Write(string format, params object[] args)
         {
-            var secs = (int)duration.TotalSeconds;
-            var time = string.Format("{0}:{1}", secs / 60, (secs % 60).ToString().PadLeft(2, '0'));
-            return time.PadLeft(6, ' ');
+            _writer.Write(new GameEvent() { time = DateTime.Now - _startTime, fields = new object[] { string.Format(format, args) } });
         }
     }
 }
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Text;
 using System.Text.RegularExpressions;
@@ -61,6 +62,13 @@ namespace InfinityScript
                 return true;
             });
 
+            // compares the typed notify invokers with reflection-based dispatch
+            OnServerCommand("notifybench", args =>
+            {
+                BenchmarkNotifyDispatch(10000);
+                return true;
+            });
+
             /*OnClientCommand("whoami", entity =>
             {
                 var name = entity.Name;
@@ -174,6 +182,50 @@ namespace InfinityScript
   
         }
 
+        internal static void BenchmarkNotifyDispatch(int count)
+        {
+            int calls = 0;
+            Action<Parameter, Parameter> handler = (a, b) => calls++;
+            var invoker = DelegateInvoker.CreateNotifyInvoker(handler);
+            var paras = new Parameter[] { "weapon", 1 };
+
+            // warm up both paths so the JIT isn't measured
+            invoker(null, paras);
+            DynamicDispatch(handler, paras);
+
+            var gen0 = GC.CollectionCount(0);
+            var watch = Stopwatch.StartNew();
+
+            for (int i = 0; i < count; i++)
+            {
+                invoker(null, paras);
+            }
+
+            watch.Stop();
+            Log.Info("{0} typed notify dispatches: {1:0.000} ms, {2} gen0 collections", count, watch.Elapsed.TotalMilliseconds, GC.CollectionCount(0) - gen0);
+
+            gen0 = GC.CollectionCount(0);
+            watch = Stopwatch.StartNew();
+
+            for (int i = 0; i < count; i++)
+            {
+                DynamicDispatch(handler, paras);
+            }
+
+            watch.Stop();
+            Log.Info("{0} DynamicInvoke notify dispatches: {1:0.000} ms, {2} gen0 collections", count, watch.Elapsed.TotalMilliseconds, GC.CollectionCount(0) - gen0);
+        }
+
+        // what the dispatch used to do for each notify
+        private static void DynamicDispatch(Delegate handler, Parameter[] paras)
+        {
+            var parameters = handler.Method.GetParameters();
+            var args = new object[parameters.Length];
+            Array.Copy(paras, args, args.Length);
+
+            handler.DynamicInvoke(args);
+        }
+
         /*  int _lastTime;
 
           void TestScript_Tick()
@@ -6,7 +6,313 @@ static VariableValue backup;
 
 VariableValue** stackPtr = (VariableValue**)0x1F3E410;
 
+#define PLAYERSNAPSHOT_CONNECTED 1
+#define PLAYERSNAPSHOT_ALIVE 2
+
 void Scriptability_HandleReturns();
+extern "C" int GI_GetPing(int entity);
+
+// a field value set by GI_SetFields, laid out like InfinityScript.FieldUpdate
+struct GI_FieldUpdate
+{
+	int entref;
+	int fieldID;
+	int type;
+	int integer;
+	float vector[3];
+};
+
+// reads a game field onto the script stack, without going through the return handling of GI_GetField;
+// the value has to be released with GI_PopField before the next script call
+static VariableValue* GI_PushField(int entNum, int fieldID)
+{
+	*(DWORD*)0x1F3BB7C += 1;
+	*(DWORD*)0x1F3E414 = 0;
+
+	DWORD _getField = 0x4A7440;
+
+	__asm
+	{
+		push fieldID
+		push entNum
+		push 0
+		call _getField
+		add esp, 0Ch
+	}
+
+	*(DWORD*)0x1F3BB7C -= 1;
+
+	if (*(DWORD*)0x1F3E414 == 0)
+	{
+		return NULL;
+	}
+
+	return *stackPtr;
+}
+
+static void GI_PopField()
+{
+	DWORD oldNumParam = *scr_numParam;
+	*scr_numParam = *(DWORD*)0x1F3E414;
+
+	__asm
+	{
+		mov eax, 4DC6C0h
+		call eax
+	}
+
+	*scr_numParam = oldNumParam;
+	*(DWORD*)0x1F3E414 = 0;
+}
+
+static void GI_ReadVectorField(int entNum, int fieldID, float* vector)
+{
+	VariableValue* value = GI_PushField(entNum, fieldID);
+
+	if (value && value->type == SCRIPT_VECTOR)
+	{
+		memcpy(vector, value->vector, sizeof(float) * 3);
+	}
+	else
+	{
+		memset(vector, 0, sizeof(float) * 3);
+	}
+
+	GI_PopField();
+}
+
+static int GI_ReadIntField(int entNum, int fieldID)
+{
+	VariableValue* value = GI_PushField(entNum, fieldID);
+	int retval = 0;
+
+	if (value && value->type == SCRIPT_INTEGER)
+	{
+		retval = value->integer;
+	}
+
+	GI_PopField();
+
+	return retval;
+}
+
+// returns the index of the string field value in names, or -1
+static int GI_ReadStringField(int entNum, int fieldID, const char** names, int numNames)
+{
+	VariableValue* value = GI_PushField(entNum, fieldID);
+	int retval = -1;
+
+	if (value && value->type == SCRIPT_STRING)
+	{
+		const char* string = SL_ConvertToString(value->string);
+
+		for (int i = 0; i < numNames; i++)
+		{
+			if (!_stricmp(string, names[i]))
+			{
+				retval = i;
+				break;
+			}
+		}
+	}
+
+	GI_PopField();
+
+	return retval;
+}
+
+// the classname of an entity as a script string, 0 if it has none; freeing an entity sets it to "freed"
+static unsigned short GI_ReadClassname(int entNum)
+{
+	VariableValue* value = GI_PushField(entNum, 1); // classname
+	unsigned short retval = 0;
+
+	if (value && value->type == SCRIPT_STRING)
+	{
+		retval = value->string;
+	}
+
+	GI_PopField();
+
+	return retval;
+}
+
+// spatial index over the origins of the connected clients and of the entities scripts added to it, kept as a grid
+// of XY cells hashed into buckets; it's built on the first query of each frame
+#define SPATIAL_MAX_ENTITIES 2048
+#define SPATIAL_NUM_BUCKETS 1024
+#define SPATIAL_CELL_SIZE 512.0f
+
+#define SPATIAL_CLIENTS 1
+#define SPATIAL_ENTITIES 2
+
+static DWORD spatialTracked[SPATIAL_MAX_ENTITIES / 32];
+
+// the classname of each tracked entity when it got tracked, to tell when its number went to another entity
+static unsigned short spatialClassnames[SPATIAL_MAX_ENTITIES];
+
+static struct
+{
+	int frame;
+	int numEntries;
+	int entNums[SPATIAL_MAX_ENTITIES];
+	int types[SPATIAL_MAX_ENTITIES];
+	float origins[SPATIAL_MAX_ENTITIES][3];
+	int cells[SPATIAL_MAX_ENTITIES][2];
+	int next[SPATIAL_MAX_ENTITIES];
+	int buckets[SPATIAL_NUM_BUCKETS];
+
+	// buckets already visited by the current query, as several cells can hash to the same bucket
+	int bucketQuery[SPATIAL_NUM_BUCKETS];
+	int query;
+
+	int candidates[SPATIAL_MAX_ENTITIES];
+} spatialIndex = { -1 };
+
+static int GI_SpatialCell(float value)
+{
+	// keeps huge query extents, like an unlimited nearest search, in the range of an int
+	if (value < -1.0e8f)
+	{
+		value = -1.0e8f;
+	}
+	else if (value > 1.0e8f)
+	{
+		value = 1.0e8f;
+	}
+
+	return (int)floorf(value / SPATIAL_CELL_SIZE);
+}
+
+static int GI_SpatialBucket(int x, int y)
+{
+	return ((x * 73856093) ^ (y * 19349663)) & (SPATIAL_NUM_BUCKETS - 1);
+}
+
+static void GI_SpatialBuild(int frame)
+{
+	if (spatialIndex.frame == frame)
+	{
+		return;
+	}
+
+	spatialIndex.frame = frame;
+	spatialIndex.numEntries = 0;
+	memset(spatialIndex.buckets, -1, sizeof(spatialIndex.buckets));
+
+	char* clients = (char*)0x49EB690;
+	int numClients = *(int*)0x49EB68C;
+
+	for (int entNum = 0; entNum < SPATIAL_MAX_ENTITIES; entNum++)
+	{
+		int type;
+
+		if (entNum < numClients)
+		{
+			if (clients[entNum * 493192] < 3)
+			{
+				continue;
+			}
+
+			type = SPATIAL_CLIENTS;
+		}
+		else if (spatialTracked[entNum >> 5] & (1 << (entNum & 31)))
+		{
+			// entities freed without the scripts untracking them drop out, as do their numbers once reused
+			unsigned short classname = GI_ReadClassname(entNum);
+
+			if (classname != spatialClassnames[entNum] || (classname && !_stricmp(SL_ConvertToString(classname), "freed")))
+			{
+				spatialTracked[entNum >> 5] &= ~(1 << (entNum & 31));
+				continue;
+			}
+
+			type = SPATIAL_ENTITIES;
+		}
+		else
+		{
+			continue;
+		}
+
+		int entry = spatialIndex.numEntries++;
+		float* origin = spatialIndex.origins[entry];
+
+		GI_ReadVectorField(entNum, 2, origin); // origin
+
+		spatialIndex.entNums[entry] = entNum;
+		spatialIndex.types[entry] = type;
+		spatialIndex.cells[entry][0] = GI_SpatialCell(origin[0]);
+		spatialIndex.cells[entry][1] = GI_SpatialCell(origin[1]);
+
+		int bucket = GI_SpatialBucket(spatialIndex.cells[entry][0], spatialIndex.cells[entry][1]);
+		spatialIndex.next[entry] = spatialIndex.buckets[bucket];
+		spatialIndex.buckets[bucket] = entry;
+	}
+}
+
+// collects the entries of the given types in the cells overlapping the XY extent of mins/maxs
+static int GI_SpatialGather(int types, const float* mins, const float* maxs)
+{
+	int minX = GI_SpatialCell(mins[0]);
+	int minY = GI_SpatialCell(mins[1]);
+	int maxX = GI_SpatialCell(maxs[0]);
+	int maxY = GI_SpatialCell(maxs[1]);
+	int numCandidates = 0;
+
+	// an area covering more cells than there are buckets is quicker to check entry by entry
+	if ((__int64)(maxX - minX + 1) * (maxY - minY + 1) > SPATIAL_NUM_BUCKETS)
+	{
+		for (int entry = 0; entry < spatialIndex.numEntries; entry++)
+		{
+			if (spatialIndex.types[entry] & types)
+			{
+				spatialIndex.candidates[numCandidates++] = entry;
+			}
+		}
+
+		return numCandidates;
+	}
+
+	spatialIndex.query++;
+
+	for (int x = minX; x <= maxX; x++)
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			int bucket = GI_SpatialBucket(x, y);
+
+			if (spatialIndex.bucketQuery[bucket] == spatialIndex.query)
+			{
+				continue;
+			}
+
+			spatialIndex.bucketQuery[bucket] = spatialIndex.query;
+
+			// the bucket may hold other cells, those outside the area get filtered out here
+			for (int entry = spatialIndex.buckets[bucket]; entry != -1; entry = spatialIndex.next[entry])
+			{
+				int cellX = spatialIndex.cells[entry][0];
+				int cellY = spatialIndex.cells[entry][1];
+
+				if ((spatialIndex.types[entry] & types) && cellX >= minX && cellX <= maxX && cellY >= minY && cellY <= maxY)
+				{
+					spatialIndex.candidates[numCandidates++] = entry;
+				}
+			}
+		}
+	}
+
+	return numCandidates;
+}
+
+static float GI_SpatialDistanceSquared(int entry, const float* point)
+{
+	float dx = spatialIndex.origins[entry][0] - point[0];
+	float dy = spatialIndex.origins[entry][1] - point[1];
+	float dz = spatialIndex.origins[entry][2] - point[2];
+
+	return (dx * dx) + (dy * dy) + (dz * dz);
+}
 
 extern "C"
 {
@@ -39,10 +345,8 @@ extern "C"
 	{
 		typedef void (__cdecl * scriptCall_t)(int entref);
 		typedef int (__cdecl * __setjmp3_t)(void* env, int a2, int a3);
-		typedef void (__cdecl* RemoveRefToValue_t)(int a1, int a2);
 
 		__setjmp3_t __setjmp3 = (__setjmp3_t)0x62DD98;
-		RemoveRefToValue_t RemoveRefToValue = (RemoveRefToValue_t)0x4D8E40;
 
 		DWORD oldNumParam = *scr_numParam;
 		*scr_numParam = numParams;
@@ -128,6 +432,35 @@ extern "C"
 		*(DWORD*)0x1F3E414 = 0;
 	}
 
+	// sets the fields scripts changed during a frame in one call; string values are an index into strings
+	__declspec(dllexport) void GI_SetFields(int count, GI_FieldUpdate* updates, const char** strings)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			GI_FieldUpdate* update = &updates[i];
+
+			switch (update->type)
+			{
+				case SCRIPT_INTEGER:
+					Scr_AddInt(update->integer);
+					break;
+				case SCRIPT_FLOAT:
+					Scr_AddFloat(update->vector[0]);
+					break;
+				case SCRIPT_STRING:
+					Scr_AddString(strings[update->integer]);
+					break;
+				case SCRIPT_VECTOR:
+					Scr_AddVector(update->vector);
+					break;
+				default:
+					continue;
+			}
+
+			GI_SetField(update->entref, update->fieldID);
+		}
+	}
+
 	__declspec(dllexport) void GI_GetField(int entref, int fieldID)
 	{
 		*(DWORD*)0x1F3BB7C += 1;
@@ -153,6 +486,166 @@ extern "C"
 		*(DWORD*)0x1F3E414 = 0;
 	}
 
+	// fills the per-client arrays (vectors take 3 floats per client) with the state of all connected players,
+	// so that scripts polling every player each frame only need a single call
+	__declspec(dllexport) int GI_GetPlayerSnapshot(int maxClients, int* flags, float* origins, float* angles, int* health, int* teams, int* pings)
+	{
+		static const char* teamNames[] = { "none", "axis", "allies", "spectator" };
+		static const char* playingState[] = { "playing" };
+
+		char* client = (char*)0x49EB690;
+		int numClients = *(int*)0x49EB68C;
+
+		if (numClients > maxClients)
+		{
+			numClients = maxClients;
+		}
+
+		for (int i = 0; i < numClients; i++, client += 493192)
+		{
+			if (*client < 3)
+			{
+				flags[i] = 0;
+				continue;
+			}
+
+			GI_ReadVectorField(i, 2, &origins[i * 3]); // origin
+			GI_ReadVectorField(i, 10, &angles[i * 3]); // angles
+			health[i] = GI_ReadIntField(i, 8); // health
+			teams[i] = GI_ReadStringField(i, 24577, teamNames, 4); // sessionteam
+			pings[i] = GI_GetPing(i);
+
+			flags[i] = PLAYERSNAPSHOT_CONNECTED;
+
+			if (health[i] > 0 && GI_ReadStringField(i, 24578, playingState, 1) == 0) // sessionstate
+			{
+				flags[i] |= PLAYERSNAPSHOT_ALIVE;
+			}
+		}
+
+		return numClients;
+	}
+
+	// adds an entity to the spatial index, or removes it; connected clients are always in it
+	__declspec(dllexport) void GI_SpatialTrack(int entNum, int track)
+	{
+		if (entNum < 0 || entNum >= SPATIAL_MAX_ENTITIES)
+		{
+			return;
+		}
+
+		if (track)
+		{
+			spatialTracked[entNum >> 5] |= (1 << (entNum & 31));
+			spatialClassnames[entNum] = GI_ReadClassname(entNum);
+		}
+		else
+		{
+			spatialTracked[entNum >> 5] &= ~(1 << (entNum & 31));
+		}
+
+		spatialIndex.frame = -1;
+	}
+
+	__declspec(dllexport) void GI_SpatialReset()
+	{
+		memset(spatialTracked, 0, sizeof(spatialTracked));
+		spatialIndex.frame = -1;
+	}
+
+	// the entity numbers within radius of center, in no particular order
+	__declspec(dllexport) int GI_SpatialRadius(int frame, int types, const float* center, float radius, int* results, int maxResults)
+	{
+		GI_SpatialBuild(frame);
+
+		float mins[2] = { center[0] - radius, center[1] - radius };
+		float maxs[2] = { center[0] + radius, center[1] + radius };
+		int numCandidates = GI_SpatialGather(types, mins, maxs);
+		int numResults = 0;
+
+		for (int i = 0; i < numCandidates && numResults < maxResults; i++)
+		{
+			int entry = spatialIndex.candidates[i];
+
+			if (GI_SpatialDistanceSquared(entry, center) <= radius * radius)
+			{
+				results[numResults++] = spatialIndex.entNums[entry];
+			}
+		}
+
+		return numResults;
+	}
+
+	// the entity numbers of up to count entities closest to center within maxDistance, closest first
+	__declspec(dllexport) int GI_SpatialNearest(int frame, int types, const float* center, float maxDistance, int* results, int count)
+	{
+		if (count <= 0)
+		{
+			return 0;
+		}
+
+		GI_SpatialBuild(frame);
+
+		if (count > SPATIAL_MAX_ENTITIES)
+		{
+			count = SPATIAL_MAX_ENTITIES;
+		}
+
+		float mins[2] = { center[0] - maxDistance, center[1] - maxDistance };
+		float maxs[2] = { center[0] + maxDistance, center[1] + maxDistance };
+		int numCandidates = GI_SpatialGather(types, mins, maxs);
+
+		static float distances[SPATIAL_MAX_ENTITIES];
+		int numResults = 0;
+
+		// insertion into the sorted results, count is expected to be small
+		for (int i = 0; i < numCandidates; i++)
+		{
+			int entry = spatialIndex.candidates[i];
+			float distance = GI_SpatialDistanceSquared(entry, center);
+
+			if (distance > maxDistance * maxDistance || (numResults == count && distance >= distances[numResults - 1]))
+			{
+				continue;
+			}
+
+			int j = (numResults < count) ? numResults++ : (numResults - 1);
+
+			for (; j > 0 && distances[j - 1] > distance; j--)
+			{
+				distances[j] = distances[j - 1];
+				results[j] = results[j - 1];
+			}
+
+			distances[j] = distance;
+			results[j] = spatialIndex.entNums[entry];
+		}
+
+		return numResults;
+	}
+
+	// the entity numbers with their origin inside the box, in no particular order
+	__declspec(dllexport) int GI_SpatialBox(int frame, int types, const float* mins, const float* maxs, int* results, int maxResults)
+	{
+		GI_SpatialBuild(frame);
+
+		int numCandidates = GI_SpatialGather(types, mins, maxs);
+		int numResults = 0;
+
+		for (int i = 0; i < numCandidates && numResults < maxResults; i++)
+		{
+			int entry = spatialIndex.candidates[i];
+			float* origin = spatialIndex.origins[entry];
+
+			if (origin[0] >= mins[0] && origin[0] <= maxs[0] && origin[1] >= mins[1] && origin[1] <= maxs[1] && origin[2] >= mins[2] && origin[2] <= maxs[2])
+			{
+				results[numResults++] = spatialIndex.entNums[entry];
+			}
+		}
+
+		return numResults;
+	}
+
 	__declspec(dllexport) void GI_TempFunc()
 	{
 		short** arrayTable = (short**)0x6EAC78;
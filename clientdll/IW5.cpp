@@ -35,6 +35,7 @@ SV_GameSendServerCommand_t SV_GameSendServerCommand = (SV_GameSendServerCommand_
 Cmd_TokenizeString_t Cmd_TokenizeString = (Cmd_TokenizeString_t)0x4BF680;
 Cmd_EndTokenizedString_t Cmd_EndTokenizedString = (Cmd_EndTokenizedString_t)0x4BF6B0;
 Scr_NotifyLevel_t Scr_NotifyLevel = (Scr_NotifyLevel_t)0x4DD3E0;
+RemoveRefToValue_t RemoveRefToValue = (RemoveRefToValue_t)0x4D8E40;
 FS_Printf_t FS_Printf = (FS_Printf_t)0x438120;
 Key_KeynumToString_t Key_KeynumToString = (Key_KeynumToString_t)0x4CCFF0;
 
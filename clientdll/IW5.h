@@ -252,6 +252,9 @@ extern Cmd_EndTokenizedString_t Cmd_EndTokenizedString;
 typedef void (__cdecl * Scr_NotifyLevel_t)(short notify, int numArgs);
 extern Scr_NotifyLevel_t Scr_NotifyLevel;
 
+typedef void (__cdecl * RemoveRefToValue_t)(int type, int value);
+extern RemoveRefToValue_t RemoveRefToValue;
+
 typedef void (__cdecl * FS_Printf_t)(int file, char* fmt, ...);
 extern FS_Printf_t FS_Printf;
 
@@ -19,9 +19,26 @@ static MonoMethod* callMethod;
 static MonoMethod* sayMethod;
 static MonoMethod* serverCommandMethod;
 static MonoMethod* clientCommandMethod;
+static MonoMethod* resetMethod;
 
 static bool monoStarted = false;
 
+// keep the script domain over map changes as long as the script files stay the same
+static bool reuseScriptDomain = false;
+static uint64_t scriptFilesHash;
+
+// SL string IDs of the notify types the managed side has handlers for
+static DWORD notifySubscriptions[65536 / 32];
+static bool notifySubscribeAll = false;
+
+// SL string IDs we hold a reference to, one per notify name ever subscribed to; kept over resets so
+// the IDs in notifySubscriptions can't get reused for other strings
+static DWORD notifyStringRefs[65536 / 32];
+
+// hashes of the lowercase command names the managed side has handlers for, console commands first and client commands second;
+// a hash collision only means a command goes through the managed side for nothing
+static DWORD commandSubscriptions[2][65536 / 32];
+
 void OutputExceptionToDebugger(MonoObject* exc)
 {
 	MonoClass* eclass = mono_object_get_class(exc);
@@ -46,8 +63,14 @@ void GI_NotifyNum(int entref, MonoString* notifyType, int numArgs);
 void GI_PushString(MonoString* string);
 MonoString* GI_NotifyType();
 MonoString* GI_Cmd_Argv_sv(int arg);
+void GI_CompileMethod(MonoMethod* method);
+MonoArray* GI_Cmd_Args();
+MonoArray* GI_Cmd_Args_sv();
+void GI_Cmd_Subscribe(MonoString* command);
+void GI_Cmd_Subscribe_sv(MonoString* command);
 MonoString* GI_Dvar_InfoString_Big(int flag);
 MonoString* GI_GetString(int index);
+void GI_SubscribeNotify(MonoString* notifyType);
 
 int count = 0;
 wchar_t wide[1024];
@@ -56,25 +79,77 @@ char skinny[1024];
 #define BUFFER_COUNT		4
 #define BUFFER_SIZE		2048
 
-static wchar_t wideBuffer[BUFFER_COUNT][BUFFER_SIZE];
-static int nextWBufferIndex = 0;
 static char skinnyBuffer[BUFFER_COUNT][BUFFER_SIZE];
 static int nextSBufferIndex = 0;
 
 MonoString* GetMonoStringFromMultiByteString(const char* mbStr)
 {
-	if (strlen(mbStr) > BUFFER_SIZE) return NULL;
+	wchar_t wideBuffer[BUFFER_SIZE];
+
+	// fails for strings that don't fit the buffer; the returned length includes the terminator
+	int length = MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, mbStr, -1, wideBuffer, BUFFER_SIZE);
+	if (length == 0) return NULL;
 
-	size_t sizeNeeded = MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, mbStr, -1, wideBuffer[nextWBufferIndex], BUFFER_SIZE);
-	if (sizeNeeded > sizeof(wchar_t) * BUFFER_SIZE) return NULL;
+	return mono_string_new_utf16(scriptDomain, (mono_unichar2*)wideBuffer, length - 1);
+}
 
-	MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, mbStr, -1, wideBuffer[nextWBufferIndex], BUFFER_SIZE);
+// interned managed strings for SL strings, pinned so that they can be handed out again without converting;
+// an SL string index gets reused once its string is freed, so entries keep their text to compare against
+struct SLStringCacheEntry
+{
+	uint32_t gcHandle;
+	MonoString* string;
+	char* text;
+};
 
-	MonoString* retval = mono_string_new_utf16(scriptDomain, (mono_unichar2*)wideBuffer[nextWBufferIndex], wcslen(wideBuffer[nextWBufferIndex]));
-	nextWBufferIndex = (nextWBufferIndex + 1) % BUFFER_COUNT;
+static SLStringCacheEntry slStringCache[65536];
 
-	return retval;
+MonoString* GetMonoStringFromSLString(unsigned short slString)
+{
+	const char* mbStr = SL_ConvertToString(slString);
+	SLStringCacheEntry* entry = &slStringCache[slString];
+
+	if (entry->string && !strcmp(entry->text, mbStr))
+	{
+		return entry->string;
+	}
+
+	MonoString* string = GetMonoStringFromMultiByteString(mbStr);
+	if (string == NULL) return NULL;
+
+	string = mono_string_intern(string);
+
+	if (entry->string)
+	{
+		mono_gchandle_free(entry->gcHandle);
+		free(entry->text);
+	}
+
+	entry->gcHandle = mono_gchandle_new((MonoObject*)string, TRUE);
+	entry->string = string;
+	entry->text = _strdup(mbStr);
+
+	return string;
 }
+
+// has to be called before the script domain goes away, as the strings belong to it
+static void ClearSLStringCache()
+{
+	for (int i = 0; i < 65536; i++)
+	{
+		SLStringCacheEntry* entry = &slStringCache[i];
+
+		if (entry->string)
+		{
+			mono_gchandle_free(entry->gcHandle);
+			free(entry->text);
+
+			entry->string = NULL;
+			entry->text = NULL;
+		}
+	}
+}
+
 char* GetMultiByteStringFromMonoString(MonoString* mStr)
 {
 	if (mono_string_length(mStr) > BUFFER_SIZE) return NULL;
@@ -112,6 +187,11 @@ void CreateScriptDomain()
 		monoStarted = true;
 	}
 
+	// the new domain registers its notify handlers and commands again
+	memset(notifySubscriptions, 0, sizeof(notifySubscriptions));
+	memset(commandSubscriptions, 0, sizeof(commandSubscriptions));
+	notifySubscribeAll = false;
+
 	//scriptDomain = mono_domain_create();
 	scriptDomain = mono_domain_create_appdomain("InfinityScript", NULL);
 	mono_domain_set(scriptDomain, true);
@@ -144,6 +224,7 @@ void CreateScriptDomain()
 	method_search("InfinityScript.SHManager:HandleSay", sayMethod);
 	method_search("InfinityScript.SHManager:HandleServerCommand", serverCommandMethod);
 	method_search("InfinityScript.SHManager:HandleClientCommand", clientCommandMethod);
+	method_search("InfinityScript.SHManager:Reset", resetMethod);
 
 	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Argv", GI_Cmd_Argv);
 	mono_add_internal_call("InfinityScript.GameInterface::Print", GI_Print);
@@ -157,6 +238,12 @@ void CreateScriptDomain()
 	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Argv_sv", GI_Cmd_Argv_sv);
 	mono_add_internal_call("InfinityScript.GameInterface::Dvar_InfoString_Big", GI_Dvar_InfoString_Big);
 	mono_add_internal_call("InfinityScript.GameInterface::Script_GetString", GI_GetString);
+	mono_add_internal_call("InfinityScript.GameInterface::Script_SubscribeNotify", GI_SubscribeNotify);
+	mono_add_internal_call("InfinityScript.GameInterface::CompileMethod", GI_CompileMethod);
+	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Args", GI_Cmd_Args);
+	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Args_sv", GI_Cmd_Args_sv);
+	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Subscribe", GI_Cmd_Subscribe);
+	mono_add_internal_call("InfinityScript.GameInterface::Cmd_Subscribe_sv", GI_Cmd_Subscribe_sv);
 
 	if (!methodSearchSuccess)
 	{
@@ -174,21 +261,112 @@ void CreateScriptDomain()
 
 void InitScripts();
 
+static void HashScriptFile(uint64_t* hash, const char* filename)
+{
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	for (const char* c = filename; *c; c++)
+	{
+		*hash = (*hash ^ (unsigned char)*c) * 0x100000001B3ULL;
+	}
+
+	static BYTE buffer[65536];
+	DWORD bytesRead;
+
+	while (ReadFile(file, buffer, sizeof(buffer), &bytesRead, NULL) && bytesRead > 0)
+	{
+		for (DWORD i = 0; i < bytesRead; i++)
+		{
+			*hash = (*hash ^ buffer[i]) * 0x100000001B3ULL;
+		}
+	}
+
+	CloseHandle(file);
+}
+
+// FNV-1a over the names and contents of InfinityScript.dll and all the script assemblies
+static uint64_t GetScriptFilesHash()
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+
+	HashScriptFile(&hash, "InfinityScript.dll");
+
+	WIN32_FIND_DATAA findData;
+	HANDLE find = FindFirstFileA("scripts\\*.dll", &findData);
+
+	if (find != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			HashScriptFile(&hash, va("scripts\\%s", findData.cFileName));
+		} while (FindNextFileA(find, &findData));
+
+		FindClose(find);
+	}
+
+	return hash;
+}
+
+static void ResetScriptDomain()
+{
+	// the new script instances register their notify handlers and commands again
+	memset(notifySubscriptions, 0, sizeof(notifySubscriptions));
+	memset(commandSubscriptions, 0, sizeof(commandSubscriptions));
+	notifySubscribeAll = false;
+
+	MonoObject* exc = NULL;
+	mono_runtime_invoke(resetMethod, NULL, NULL, &exc);
+
+	if (exc)
+	{
+		OutputExceptionToDebugger(exc);
+	}
+}
+
 void InitScriptDomain()
 {
 	// re-enable dropping weapons
 	//*(WORD*)0x47D53B = 0x0B75;
 
+	DWORD startTime = timeGetTime();
+	bool reused = false;
+
 	// stuff
 	if (monoStarted)
 	{
-		mono_domain_unload(scriptDomain);
-		mono_domain_set(rootDomain, true);
+		uint64_t hash = GetScriptFilesHash();
+
+		if (reuseScriptDomain && hash == scriptFilesHash)
+		{
+			ResetScriptDomain();
+			reused = true;
+		}
+		else
+		{
+			ClearSLStringCache();
+			mono_domain_unload(scriptDomain);
+			mono_domain_set(rootDomain, true);
+
+			CreateScriptDomain();
+		}
+
+		scriptFilesHash = hash;
+	}
+	else
+	{
+		CreateScriptDomain();
+		scriptFilesHash = GetScriptFilesHash();
 	}
 
-	CreateScriptDomain();
 	InitScripts();
 
+	Com_Printf(0, "Script domain %s in %d msec.\n", (reused) ? "reset" : "loaded", timeGetTime() - startTime);
+
 	__asm
 	{
 		mov eax, 4D97B0h
@@ -260,6 +438,17 @@ void Script_SetLoad_f()
 	enabledScripts.push_front(script);
 }
 
+void Script_SetReuseDomain_f()
+{
+	if (Cmd_Argc() != 2)
+	{
+		Com_Printf(0, "usage: reuseScriptDomain [0/1]\n");
+		return;
+	}
+
+	reuseScriptDomain = (atoi(Cmd_Argv(1)) != 0);
+}
+
 void Script_SetUnload_f()
 {
 	if (Cmd_Argc() != 2)
@@ -358,13 +547,18 @@ void __declspec(naked) StoreTempEntRef()
 
 static VariableValue* notifyStack;
 static int notifyNumArgs;
-static const char* notifyType;
+static unsigned short notifyType;
 
 void NotifyScript(int entity, unsigned short type, VariableValue* stack)
 {
+	// don't enter the script domain for notifies nobody listens to
+	if (!notifySubscribeAll && !(notifySubscriptions[type >> 5] & (1 << (type & 31))))
+	{
+		return;
+	}
+
 	notifyStack = stack;
 
-	const char* string = SL_ConvertToString(type);
 	int numArgs = 0;
 
 	if (stack->type != 8)
@@ -376,7 +570,7 @@ void NotifyScript(int entity, unsigned short type, VariableValue* stack)
 	}
 
 	notifyNumArgs = numArgs;
-	notifyType = string;
+	notifyType = type;
 
 	void* args[1];
 	args[0] = &entity;
@@ -484,8 +678,10 @@ void InitScriptability()
 {
 	static cmd_function_s loadScript;
 	static cmd_function_s unloadScript;
+	static cmd_function_s reuseDomain;
 	Cmd_AddCommand("loadScript", Script_SetLoad_f, &loadScript);
 	Cmd_AddCommand("unloadScript", Script_SetUnload_f, &unloadScript);
+	Cmd_AddCommand("reuseScriptDomain", Script_SetReuseDomain_f, &reuseDomain);
 
 	call(0x489F88, ProcessScripts, PATCH_CALL);
 	call(0x48A73F, InitScriptDomain, PATCH_CALL);
@@ -524,9 +720,31 @@ bool Scriptability_OnSay(int client, char* name, char** textptr, int team)
 	return !(*retval);
 }
 
+// FNV-1a of the lowercase command name, folded to 16 bits
+static unsigned short GetCommandHash(const char* command)
+{
+	uint32_t hash = 2166136261u;
+
+	for (; *command; command++)
+	{
+		hash ^= (unsigned char)tolower(*command);
+		hash *= 16777619u;
+	}
+
+	return (unsigned short)(hash ^ (hash >> 16));
+}
+
+static bool IsCommandSubscribed(int type, const char* command)
+{
+	unsigned short hash = GetCommandHash(command);
+
+	return (commandSubscriptions[type][hash >> 5] & (1 << (hash & 31))) != 0;
+}
+
 bool Scriptability_ServerCommand(const char* command)
 {
-	if (serverCommandMethod != NULL)
+	// commands no script handles don't need to go through mono at all
+	if (serverCommandMethod != NULL && IsCommandSubscribed(0, command))
 	{	
 		MonoString* cmdStr = GetMonoStringFromMultiByteString(command);
 		if (cmdStr != NULL)
@@ -552,7 +770,8 @@ bool Scriptability_ServerCommand(const char* command)
 
 bool Scriptability_ClientCommand(const char* command, int client)
 {
-	if (clientCommandMethod != NULL)
+	// this runs for every client command, most of which no script cares about
+	if (clientCommandMethod != NULL && IsCommandSubscribed(1, command))
 	{
 		MonoString* cmdStr = GetMonoStringFromMultiByteString(command);
 		if (cmdStr != NULL)
@@ -609,10 +828,9 @@ extern "C" __declspec(dllexport) int GI_GetInt(int index)
 
 MonoString* GI_GetString(int index)
 {
-	char* retval = SL_ConvertToString((notifyStack[-index]).string);
-	MonoString* cmdStr = GetMonoStringFromMultiByteString(retval);
+	MonoString* cmdStr = GetMonoStringFromSLString((notifyStack[-index]).string);
 	if (cmdStr != NULL)  return cmdStr;
-	else mono_string_new(scriptDomain, "");
+	else return mono_string_new(scriptDomain, "");
 }
 
 extern "C" __declspec(dllexport) float GI_GetFloat(int index)
@@ -679,6 +897,64 @@ MonoString* GI_Cmd_Argv_sv(int arg)
 	else return mono_string_new(scriptDomain, "");
 }
 
+// a RuntimeMethodHandle is the MonoMethod itself
+void GI_CompileMethod(MonoMethod* method)
+{
+	if (method != NULL)
+	{
+		mono_compile_method(method);
+	}
+}
+
+// all the arguments of the command in a single call, with argv[0] being the command itself
+static MonoArray* GetCommandArgs(int argc, char* (*argv)(int))
+{
+	MonoArray* args = mono_array_new(scriptDomain, mono_get_string_class(), argc);
+
+	for (int i = 0; i < argc; i++)
+	{
+		MonoString* arg = GetMonoStringFromMultiByteString(argv(i));
+
+		if (arg == NULL)
+		{
+			arg = mono_string_new(scriptDomain, "");
+		}
+
+		mono_array_setref(args, i, arg);
+	}
+
+	return args;
+}
+
+MonoArray* GI_Cmd_Args()
+{
+	return GetCommandArgs(Cmd_Argc(), Cmd_Argv);
+}
+
+MonoArray* GI_Cmd_Args_sv()
+{
+	return GetCommandArgs(Cmd_Argc_sv(), Cmd_Argv_sv);
+}
+
+static void SubscribeCommand(int type, MonoString* command)
+{
+	char* mbStr = GetMultiByteStringFromMonoString(command);
+	if (mbStr == NULL) return;
+
+	unsigned short hash = GetCommandHash(mbStr);
+	commandSubscriptions[type][hash >> 5] |= (1 << (hash & 31));
+}
+
+void GI_Cmd_Subscribe(MonoString* command)
+{
+	SubscribeCommand(0, command);
+}
+
+void GI_Cmd_Subscribe_sv(MonoString* command)
+{
+	SubscribeCommand(1, command);
+}
+
 extern "C" __declspec(dllexport) int GI_GetPing(int entity)
 {
 	return *(int*)(0x4A0CB08 + (0x1E1A2 * entity));
@@ -763,9 +1039,35 @@ void GI_PushString(MonoString* string)
 	if (mbStr != NULL) Scr_AddString(mbStr);
 }
 
+void GI_SubscribeNotify(MonoString* notifyType)
+{
+	char* mbStr = GetMultiByteStringFromMonoString(notifyType);
+	if (mbStr == NULL) return;
+
+	unsigned short notifyTypeStr = SL_GetString(mbStr, 0);
+	DWORD bit = (1 << (notifyTypeStr & 31));
+
+	// SL_GetString added a reference; only keep the first one for each name
+	if (notifyStringRefs[notifyTypeStr >> 5] & bit)
+	{
+		RemoveRefToValue(SCRIPT_STRING, notifyTypeStr);
+	}
+	else
+	{
+		notifyStringRefs[notifyTypeStr >> 5] |= bit;
+	}
+
+	notifySubscriptions[notifyTypeStr >> 5] |= bit;
+}
+
+extern "C" __declspec(dllexport) void GI_SubscribeAllNotifies()
+{
+	notifySubscribeAll = true;
+}
+
 MonoString* GI_NotifyType()
 {
-	MonoString* mStr = GetMonoStringFromMultiByteString(notifyType);
+	MonoString* mStr = GetMonoStringFromSLString(notifyType);
 	if (mStr) return mStr;
 	else return mono_string_new(scriptDomain, "");
 }
@@ -0,0 +1,416 @@
+/*
+	challenges.c
+
+	Stateless challenge management for dpmaster
+
+	Copyright (C) 2004-2011  Mathieu Olivier
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+#include "common.h"
+#include "system.h"
+#include "challenges.h"
+#include "games.h"
+
+
+// ---------- Constants ---------- //
+
+// Length of a time bucket (in seconds). A challenge is accepted during the
+// time bucket it has been built in, and during the following one
+#define CHALLENGE_BUCKET_TIME 5
+
+// Lifetime of a challenge secret (in seconds)
+#define SECRET_LIFETIME (60 * 60)
+
+// A challenge is made of a payload (game index and alternate port), followed by a MAC
+#define PAYLOAD_NB_CHARS	5
+#define MAC_NB_CHARS		(CHALLENGE_LENGTH - 1 - PAYLOAD_NB_CHARS)
+
+// Number of bits stored in each challenge character
+#define BITS_PER_CHAR 6
+
+// Maximum game index we can store in a payload
+#define MAX_GAME_INDEX ((1 << (PAYLOAD_NB_CHARS * BITS_PER_CHAR - 16)) - 1)
+
+
+// ---------- Private types ---------- //
+
+typedef unsigned long long sipword_t;
+
+// Challenge secret (a SipHash key)
+typedef struct
+{
+	sipword_t k0;
+	sipword_t k1;
+} secret_t;
+
+
+// ---------- Private variables ---------- //
+
+// Characters used in the challenges (64 of them, none forbidden by the protocols)
+static const char challenge_chars [] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+-";
+
+// The current secret, and the previous one
+static secret_t secrets [2];
+
+// Generation of the current secret
+static time_t secret_generation = 0;
+
+
+// ---------- Public variables ---------- //
+
+// Do heartbeats from unknown servers leave the server list untouched?
+qboolean stateless_challenges = false;
+
+
+// ---------- Private functions ---------- //
+
+#define SIP_ROTL(x, b) (sipword_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3)		\
+	do									\
+	{									\
+		v0 += v1;						\
+		v1 = SIP_ROTL (v1, 13);			\
+		v1 ^= v0;						\
+		v0 = SIP_ROTL (v0, 32);			\
+		v2 += v3;						\
+		v3 = SIP_ROTL (v3, 16);			\
+		v3 ^= v2;						\
+		v0 += v3;						\
+		v3 = SIP_ROTL (v3, 21);			\
+		v3 ^= v0;						\
+		v2 += v1;						\
+		v1 = SIP_ROTL (v1, 17);			\
+		v1 ^= v2;						\
+		v2 = SIP_ROTL (v2, 32);			\
+	} while (0)
+
+
+/*
+====================
+Ch_SipHash
+
+Compute the SipHash-2-4 MAC of a buffer
+====================
+*/
+static sipword_t Ch_SipHash (const secret_t* secret, const qbyte* data, size_t size)
+{
+	sipword_t v0 = secret->k0 ^ 0x736F6D6570736575ULL;
+	sipword_t v1 = secret->k1 ^ 0x646F72616E646F6DULL;
+	sipword_t v2 = secret->k0 ^ 0x6C7967656E657261ULL;
+	sipword_t v3 = secret->k1 ^ 0x7465646279746573ULL;
+	sipword_t last_word = (sipword_t)size << 56;
+	size_t ind;
+
+	for (ind = 0; ind + 8 <= size; ind += 8)
+	{
+		sipword_t word = 0;
+		unsigned int byte_ind;
+
+		for (byte_ind = 0; byte_ind < 8; byte_ind++)
+			word |= (sipword_t)data[ind + byte_ind] << (8 * byte_ind);
+
+		v3 ^= word;
+		SIP_ROUND (v0, v1, v2, v3);
+		SIP_ROUND (v0, v1, v2, v3);
+		v0 ^= word;
+	}
+
+	for (; ind < size; ind++)
+		last_word |= (sipword_t)data[ind] << (8 * (ind & 7));
+
+	v3 ^= last_word;
+	SIP_ROUND (v0, v1, v2, v3);
+	SIP_ROUND (v0, v1, v2, v3);
+	v0 ^= last_word;
+
+	v2 ^= 0xFF;
+	SIP_ROUND (v0, v1, v2, v3);
+	SIP_ROUND (v0, v1, v2, v3);
+	SIP_ROUND (v0, v1, v2, v3);
+	SIP_ROUND (v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+
+/*
+====================
+Ch_GenerateSecret
+
+Generate a new random secret
+====================
+*/
+static qboolean Ch_GenerateSecret (secret_t* secret)
+{
+	if (! Sys_GetRandomBytes (secret, sizeof (*secret)))
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: can't generate a new challenge secret\n");
+		return false;
+	}
+
+	return true;
+}
+
+
+/*
+====================
+Ch_UpdateSecrets
+
+Rotate the secrets if the current one has expired
+====================
+*/
+static void Ch_UpdateSecrets (void)
+{
+	time_t generation = crt_time / SECRET_LIFETIME;
+	secret_t new_secret;
+
+	if (generation == secret_generation)
+		return;
+
+	// If we can't get a new secret, keep using the current one for now
+	if (! Ch_GenerateSecret (&new_secret))
+		new_secret = secrets[0];
+
+	// The previous secret is only useful if it's from the previous generation
+	if (generation == secret_generation + 1)
+		secrets[1] = secrets[0];
+	else
+		secrets[1] = new_secret;
+	secrets[0] = new_secret;
+	secret_generation = generation;
+
+	Com_Printf (MSG_DEBUG, "> Challenge secret rotated\n");
+}
+
+
+/*
+====================
+Ch_ComputeMAC
+
+Compute the MAC of a challenge for a given address, time bucket and payload
+Return "false" if the secret of this time bucket isn't available anymore
+====================
+*/
+static qboolean Ch_ComputeMAC (const struct sockaddr_storage* address,
+							   time_t bucket, unsigned int payload,
+							   sipword_t* mac)
+{
+	const secret_t* secret;
+	time_t generation;
+	qbyte data [1 + 16 + 2 + 8 + 4];
+	size_t size = 0;
+	unsigned int ind;
+
+	// Find the secret used during this time bucket
+	generation = bucket * CHALLENGE_BUCKET_TIME / SECRET_LIFETIME;
+	if (generation == secret_generation)
+		secret = &secrets[0];
+	else if (generation == secret_generation - 1)
+		secret = &secrets[1];
+	else
+		return false;
+
+	// Address family, address and port
+	data[size++] = (qbyte)address->ss_family;
+	if (address->ss_family == AF_INET6)
+	{
+		const struct sockaddr_in6* addr6 = (const struct sockaddr_in6*)address;
+
+		memcpy (&data[size], &addr6->sin6_addr.s6_addr, 16);
+		size += 16;
+		memcpy (&data[size], &addr6->sin6_port, 2);
+		size += 2;
+	}
+	else
+	{
+		const struct sockaddr_in* addr4 = (const struct sockaddr_in*)address;
+
+		assert (address->ss_family == AF_INET);
+
+		memcpy (&data[size], &addr4->sin_addr.s_addr, 4);
+		size += 4;
+		memcpy (&data[size], &addr4->sin_port, 2);
+		size += 2;
+	}
+
+	// Time bucket and payload
+	for (ind = 0; ind < 8; ind++)
+		data[size++] = (qbyte)((unsigned long long)bucket >> (8 * ind));
+	for (ind = 0; ind < 4; ind++)
+		data[size++] = (qbyte)(payload >> (8 * ind));
+
+	assert (size <= sizeof (data));
+	*mac = Ch_SipHash (secret, data, size);
+	return true;
+}
+
+
+/*
+====================
+Ch_Encode
+
+Write a value in a challenge string, BITS_PER_CHAR bits per character
+====================
+*/
+static void Ch_Encode (char* dest, sipword_t value, unsigned int nb_chars)
+{
+	unsigned int ind;
+
+	for (ind = 0; ind < nb_chars; ind++)
+	{
+		dest[ind] = challenge_chars[value & ((1 << BITS_PER_CHAR) - 1)];
+		value >>= BITS_PER_CHAR;
+	}
+}
+
+
+/*
+====================
+Ch_Decode
+
+Read a value from a challenge string. Return "false" if it contains an invalid character
+====================
+*/
+static qboolean Ch_Decode (const char* src, sipword_t* value, unsigned int nb_chars)
+{
+	unsigned int ind;
+
+	*value = 0;
+	for (ind = 0; ind < nb_chars; ind++)
+	{
+		const char* char_ptr;
+
+		if (src[ind] == '\0')
+			return false;
+		char_ptr = strchr (challenge_chars, src[ind]);
+		if (char_ptr == NULL)
+			return false;
+
+		*value |= (sipword_t)(char_ptr - challenge_chars) << (BITS_PER_CHAR * ind);
+	}
+
+	return true;
+}
+
+
+// ---------- Public functions ---------- //
+
+/*
+====================
+Ch_Init
+
+Generate the first challenge secret
+====================
+*/
+qboolean Ch_Init (void)
+{
+	if (! Ch_GenerateSecret (&secrets[0]))
+		return false;
+	secrets[1] = secrets[0];
+	secret_generation = crt_time / SECRET_LIFETIME;
+
+	if (stateless_challenges)
+		Com_Printf (MSG_NORMAL, "> Stateless challenges enabled\n");
+
+	return true;
+}
+
+
+/*
+====================
+Ch_Build
+
+Build the challenge string of a "getinfo" message for this address.
+The game properties and the alternate port are embedded in it
+====================
+*/
+const char* Ch_Build (const struct sockaddr_storage* address,
+					  const game_properties_t* game_props,
+					  unsigned short alt_port)
+{
+	static char challenge [CHALLENGE_LENGTH];
+	unsigned int game_index;
+	unsigned int payload;
+	time_t bucket;
+	sipword_t mac;
+
+	Ch_UpdateSecrets ();
+
+	game_index = Game_GetPropertiesIndex (game_props);
+	assert (game_index <= MAX_GAME_INDEX);
+	payload = (game_index << 16) | alt_port;
+
+	bucket = crt_time / CHALLENGE_BUCKET_TIME;
+	if (! Ch_ComputeMAC (address, bucket, payload, &mac))
+	{
+		// The current secret is always available
+		assert (false);
+		mac = 0;
+	}
+
+	Ch_Encode (challenge, payload, PAYLOAD_NB_CHARS);
+	Ch_Encode (challenge + PAYLOAD_NB_CHARS, mac, MAC_NB_CHARS);
+	challenge[CHALLENGE_LENGTH - 1] = '\0';
+
+	return challenge;
+}
+
+
+/*
+====================
+Ch_Check
+
+Check a challenge sent back by a server, and extract its game properties and alternate port
+====================
+*/
+qboolean Ch_Check (const char* challenge,
+				   const struct sockaddr_storage* address,
+				   const game_properties_t** game_props,
+				   unsigned short* alt_port)
+{
+	sipword_t payload, mac, expected_mac;
+	sipword_t mac_mask = ((sipword_t)1 << (MAC_NB_CHARS * BITS_PER_CHAR)) - 1;
+	time_t bucket;
+	qboolean valid_index;
+
+	if (strlen (challenge) != CHALLENGE_LENGTH - 1 ||
+		! Ch_Decode (challenge, &payload, PAYLOAD_NB_CHARS) ||
+		! Ch_Decode (challenge + PAYLOAD_NB_CHARS, &mac, MAC_NB_CHARS))
+		return false;
+
+	Ch_UpdateSecrets ();
+
+	// Accept the current time bucket, and the previous one
+	bucket = crt_time / CHALLENGE_BUCKET_TIME;
+	if (! Ch_ComputeMAC (address, bucket, (unsigned int)payload, &expected_mac) ||
+		(expected_mac & mac_mask) != mac)
+	{
+		if (! Ch_ComputeMAC (address, bucket - 1, (unsigned int)payload, &expected_mac) ||
+			(expected_mac & mac_mask) != mac)
+			return false;
+	}
+
+	*game_props = Game_GetPropertiesByIndex ((unsigned int)(payload >> 16), &valid_index);
+	if (! valid_index)
+		return false;
+
+	*alt_port = (unsigned short)(payload & 0xFFFF);
+	return true;
+}
@@ -0,0 +1,63 @@
+/*
+	challenges.h
+
+	Stateless challenge management for dpmaster
+
+	Copyright (C) 2004-2011  Mathieu Olivier
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+#ifndef _CHALLENGES_H_
+#define _CHALLENGES_H_
+
+
+// ---------- Constants ---------- //
+
+// Number of characters in a challenge, including the '\0'
+#define CHALLENGE_LENGTH 12
+
+
+// ---------- Types ---------- //
+
+struct game_properties_s;		// Defined in games.h
+
+
+// ---------- Public variables ---------- //
+
+// Do heartbeats from unknown servers leave the server list untouched?
+extern qboolean stateless_challenges;
+
+
+// ---------- Public functions ---------- //
+
+// Generate the first challenge secret
+qboolean Ch_Init (void);
+
+// Build the challenge string of a "getinfo" message for this address.
+// The game properties and the alternate port are embedded in it
+const char* Ch_Build (const struct sockaddr_storage* address,
+					  const struct game_properties_s* game_props,
+					  unsigned short alt_port);
+
+// Check a challenge sent back by a server, and extract its game properties and alternate port
+qboolean Ch_Check (const char* challenge,
+				   const struct sockaddr_storage* address,
+				   const struct game_properties_s** game_props,
+				   unsigned short* alt_port);
+
+
+#endif  // #ifndef _CHALLENGES_H_
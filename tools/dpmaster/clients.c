@@ -32,8 +32,11 @@
 typedef struct client_s
 {
 	user_t user;		// WARNING: MUST be the 1st member, for compatibility with the user hash tables
-	int count;
-	time_t last_time;
+	int tokens;			// number of queries the client can still send right now
+	time_t last_refill;
+	time_t last_seen;
+	struct client_s* lru_prev;
+	struct client_s* lru_next;
 } client_t;
 
 
@@ -45,13 +48,23 @@ static unsigned int max_nb_clients = DEFAULT_MAX_NB_CLIENTS;
 static user_hash_table_t hash_clients;
 static size_t cl_hash_size = DEFAULT_CL_HASH_SIZE;
 
-// rolling window for allocation
-static int last_used_slot = -1;
+// All client structures, used or not, are part of a list sorted by last
+// activity. The most recently seen client is at its head, and the tail is
+// the slot we recycle when a new client shows up (free slots stay at the tail)
+static client_t* lru_head = NULL;
+static client_t* lru_tail = NULL;
 
 // Allow "throttle - 1" queries in a row, then force a throttle to one every "decay time" seconds
 static time_t fp_decay_time = DEFAULT_FP_DECAY_TIME;
 static int fp_throttle = DEFAULT_FP_THROTTLE;
 
+// New clients may only push out a client seen within the last "throttle * decay time"
+// seconds (whose bucket still matters) at this global rate, so that a flood of spoofed
+// sources can neither flush the table nor get every one of its queries answered
+static int new_client_rate = 0;
+static int new_client_tokens = 0;
+static time_t new_client_refill = 0;
+
 
 // ---------- Public variables ---------- //
 
@@ -63,91 +76,158 @@ qboolean flood_protection = false;
 
 /*
 ====================
-Cl_QueryThrottleDecay
+Cl_LRU_Unlink
 
-Compute the current throttle value of a client
+Remove a client from the LRU list
 ====================
 */
-static int Cl_QueryThrottleDecay( client_t *client )
+static void Cl_LRU_Unlink (client_t* client)
 {
-	int count = client->count - (int)((crt_time - client->last_time) / fp_decay_time);
-	if ( count < 0 )
-		count = 0;
+	if (client->lru_prev != NULL)
+		client->lru_prev->lru_next = client->lru_next;
+	else
+		lru_head = client->lru_next;
 
-	return count;
+	if (client->lru_next != NULL)
+		client->lru_next->lru_prev = client->lru_prev;
+	else
+		lru_tail = client->lru_prev;
 }
 
 
 /*
 ====================
-Cl_AddClient
+Cl_LRU_PushFront
 
-Add a client to an hash table
+Put a client at the head of the LRU list (it must not be in the list)
 ====================
 */
-static qboolean Cl_AddClient( const struct sockaddr_storage *address, socklen_t addrlen )
+static void Cl_LRU_PushFront (client_t* client)
 {
-	int first_slot = ( last_used_slot + 1 ) % max_nb_clients;
-	int free_slot = first_slot;
-	client_t* free_client = NULL;
+	client->lru_prev = NULL;
+	client->lru_next = lru_head;
+	if (lru_head != NULL)
+		lru_head->lru_prev = client;
+	else
+		lru_tail = client;
+	lru_head = client;
+}
 
-	// look for the next free slot
-	do
-	{
-		int count;
-		client_t* client = &clients[ free_slot ];
 
-		if ( client->user.prev_ptr == NULL )
-		{
-			// this slot is not in use
-			free_client = client;
-			break;
-		}
+/*
+====================
+Cl_RefillTokens
 
-		// the rolling window lets us retire inactive queries
-		assert( client->count != 0 );
-		count = Cl_QueryThrottleDecay( client );
-		if ( count == 0 )
-		{
-			// this entry is expired, remove from the hash
-			Com_UserHashTable_Remove( &client->user );
-			free_client = client;
-			Com_Printf( MSG_DEBUG, "> Reusing expired client entry %d\n", (int)(client - clients) );
-			break;
-		}
+Give a client the tokens it has earned since its last refill
+====================
+*/
+static void Cl_RefillTokens (client_t* client)
+{
+	int max_tokens = fp_throttle - 1;
+	time_t nb_periods = (crt_time - client->last_refill) / fp_decay_time;
 
-		free_slot = ( free_slot + 1 ) % max_nb_clients;
+	if (nb_periods <= 0)
+		return;
+
+	if (nb_periods >= max_tokens - client->tokens)
+	{
+		client->tokens = max_tokens;
+		client->last_refill = crt_time;
+	}
+	else
+	{
+		client->tokens += (int)nb_periods;
+		client->last_refill += nb_periods * fp_decay_time;
 	}
-	while ( free_slot != first_slot );
+}
+
 
-	if ( free_client != NULL )
+/*
+====================
+Cl_TakeNewClientToken
+
+Return "true" if the global budget allows one more recent client to be evicted
+====================
+*/
+static qboolean Cl_TakeNewClientToken (void)
+{
+	time_t elapsed = crt_time - new_client_refill;
+
+	if (elapsed > 0)
 	{
-		int hash;
+		// The budget holds at most one second worth of new clients
+		if (elapsed >= 1)
+			new_client_tokens = new_client_rate;
+		new_client_refill = crt_time;
+	}
 
-		last_used_slot = free_slot;
+	if (new_client_tokens <= 0)
+		return false;
+
+	new_client_tokens--;
+	return true;
+}
 
-		memcpy( &free_client->user.address, address, sizeof( free_client->user.address ) );
-		free_client->user.addrlen = addrlen;
-		free_client->count = 1;
-		free_client->last_time = crt_time;
 
-		hash = Com_AddressHash( address, cl_hash_size );
-		Com_UserHashTable_Add( &hash_clients, &free_client->user, hash );
+/*
+====================
+Cl_AddClient
+
+Add a client to an hash table, recycling the least recently seen slot.
+Return "false" if the client was refused because the table is full of recent clients
+====================
+*/
+static qboolean Cl_AddClient( const struct sockaddr_storage *address, socklen_t addrlen )
+{
+	client_t* client = lru_tail;
+	unsigned int hash;
+	qboolean on_probation = false;
+
+	assert( client != NULL );
+
+	// If this slot is in use, evict its client
+	if ( client->user.prev_ptr != NULL )
+	{
+		if ( crt_time - client->last_seen < fp_decay_time * fp_throttle )
+		{
+			if ( ! Cl_TakeNewClientToken() )
+			{
+				Com_Printf( MSG_NORMAL, "> Client %s: refused (too many new clients)\n", peer_address );
+				return false;
+			}
 
-		Com_Printf( MSG_DEBUG,
-					"> New client added: %s\n"
-					"  - index: %u\n"
-					"  - hash: 0x%04X\n",
-					peer_address, free_slot, hash );
-		return true;
+			// The table is under pressure: keep the new client at the tail of the
+			// LRU list until it queries again, so that a flood of one-shot sources
+			// only recycles its own entries and not those of the established clients
+			on_probation = true;
+		}
+
+		Com_UserHashTable_Remove( &client->user );
+		Com_Printf( MSG_DEBUG, "> Recycling least recently seen client entry %u\n",
+					(unsigned int)(client - clients) );
 	}
-	else
+
+	memcpy( &client->user.address, address, sizeof( client->user.address ) );
+	client->user.addrlen = addrlen;
+	client->tokens = fp_throttle - 2;	// this query consumes one token
+	client->last_refill = crt_time;
+	client->last_seen = crt_time;
+
+	hash = Com_AddressHash( address, cl_hash_size );
+	Com_UserHashTable_Add( &hash_clients, &client->user, hash );
+
+	if ( ! on_probation )
 	{
-		Com_Printf (MSG_WARNING,
-					"> WARNING: can't add client %s (client list is full)\n",
-					peer_address);
-		return false;
+		Cl_LRU_Unlink( client );
+		Cl_LRU_PushFront( client );
 	}
+
+	Com_Printf( MSG_DEBUG,
+				"> New client added: %s\n"
+				"  - index: %u\n"
+				"  - hash: 0x%04X\n",
+				peer_address, (unsigned int)(client - clients), hash );
+	return true;
 }
 
 
@@ -238,8 +318,7 @@ qboolean Cl_Init( void )
 	if ( flood_protection )
 	{
 		size_t array_size;
-
-		last_used_slot = -1;
+		unsigned int ind;
 
 		// data
 		array_size = max_nb_clients * sizeof( clients[0] );
@@ -253,8 +332,21 @@ qboolean Cl_Init( void )
 		}
 		memset( clients, 0, array_size );
 
+		// All slots start in the LRU list, as free slots
+		lru_head = NULL;
+		lru_tail = NULL;
+		for ( ind = 0; ind < max_nb_clients; ind++ )
+			Cl_LRU_PushFront( &clients[ ind ] );
+
 		Com_Printf( MSG_NORMAL, "> %u client records allocated\n", max_nb_clients );
 
+		// Enough to replace the whole table once per bucket lifetime
+		new_client_rate = (int)(max_nb_clients / (fp_decay_time * fp_throttle));
+		if (new_client_rate < 1)
+			new_client_rate = 1;
+		new_client_tokens = new_client_rate;
+		new_client_refill = crt_time;
+
 		if (! Com_UserHashTable_Init (&hash_clients, cl_hash_size, "client"))
 			return false;
 	}
@@ -304,16 +396,16 @@ qboolean Cl_BlockedByThrottle( const struct sockaddr_storage* addr, socklen_t ad
 			{
 				msg_level_t msg_level;
 				const char* msg_result;
+				qboolean is_blocked;
 
-				int new_count = Cl_QueryThrottleDecay( client ) + 1;
-				qboolean is_blocked = ( new_count >= fp_throttle );
+				Cl_RefillTokens( client );
+				client->last_seen = crt_time;
+				is_blocked = ( client->tokens <= 0 );
 				if ( ! is_blocked )
 				{
-					client->count = new_count;
-					client->last_time = crt_time;
+					client->tokens--;
 					msg_level = MSG_DEBUG;
 					msg_result = "not throttled";
-
 				}
 				else
 				{
@@ -321,7 +413,14 @@ qboolean Cl_BlockedByThrottle( const struct sockaddr_storage* addr, socklen_t ad
 					msg_result = "throttled";
 				}
 
-				Com_Printf( msg_level, "> Client %s: %s (new count == %d)\n", peer_address, msg_result, new_count );
+				// Move it on top of the LRU list
+				if ( client != lru_head )
+				{
+					Cl_LRU_Unlink( client );
+					Cl_LRU_PushFront( client );
+				}
+
+				Com_Printf( msg_level, "> Client %s: %s (tokens left: %d)\n", peer_address, msg_result, client->tokens );
 				return is_blocked;
 			}
 		}
@@ -330,5 +429,5 @@ qboolean Cl_BlockedByThrottle( const struct sockaddr_storage* addr, socklen_t ad
 	}
 
 	assert( client == NULL );
-	return ( ! Cl_AddClient( addr, addrlen ) );
+	return ! Cl_AddClient( addr, addrlen );
 }
@@ -27,6 +27,100 @@
 #include "servers.h"
 
 
+// ---------- Constants ---------- //
+
+// Size of the asynchronous log ring, in bytes (must be a power of 2)
+#define LOG_RING_SIZE (1 << 20)
+
+// Maximum size of a log record, in bytes
+#define LOG_MAX_RECORD_SIZE 4096
+
+// Maximum number of arguments in a log record
+#define LOG_MAX_ARGS 32
+
+// Log records are aligned on this size, in bytes
+#define LOG_RECORD_ALIGN 8
+#define LOG_ALIGN(size) (((size) + LOG_RECORD_ALIGN - 1) & ~(size_t)(LOG_RECORD_ALIGN - 1))
+
+// Size of a log record header, in bytes
+#define LOG_HEADER_SIZE LOG_ALIGN (sizeof (log_record_t))
+
+// How long the log writer waits when it has nothing to do (in milliseconds)
+#define LOG_WRITER_SLEEP 10
+
+// How long we wait for the log writer to empty the ring when exiting (in milliseconds)
+#define LOG_STOP_TIMEOUT 2000
+
+
+// ---------- Private types ---------- //
+
+// Types of log records
+typedef enum
+{
+	LOG_RECORD_MESSAGE,		// a message to format and print
+	LOG_RECORD_DATE,		// a time stamp to print
+	LOG_RECORD_SET_FILE,	// the new log file (or NULL)
+	LOG_RECORD_PADDING,		// unused space at the end of the ring
+} log_record_type_t;
+
+// Header of a log record. For a message, the arguments and their strings follow it
+typedef struct
+{
+	unsigned int size;			// including the header, multiple of LOG_RECORD_ALIGN
+	log_record_type_t type;
+	unsigned int nb_args;
+	time_t date;
+	const char* format;			// must be a string literal
+	FILE* file;
+} log_record_t;
+
+// Argument of a log message
+typedef union
+{
+	long long int_value;
+	unsigned long long uint_value;
+	double float_value;
+	const void* ptr_value;
+	struct
+	{
+		unsigned int offset;	// from the start of the record (0 for a NULL string)
+		unsigned int length;
+	} str_value;
+} log_arg_t;
+
+// Kinds of conversions in a format string
+typedef enum
+{
+	LOG_ARG_NONE,			// "%%" or unsupported conversion: no argument
+	LOG_ARG_INT,
+	LOG_ARG_UINT,
+	LOG_ARG_FLOAT,
+	LOG_ARG_PTR,
+	LOG_ARG_STRING,
+	LOG_ARG_CHAR,
+} log_arg_kind_t;
+
+// Size of an integer argument, as read from the variable argument list
+typedef enum
+{
+	LOG_SIZE_INT,
+	LOG_SIZE_LONG,
+	LOG_SIZE_LONGLONG,
+	LOG_SIZE_SIZET,
+} log_arg_size_t;
+
+// A conversion specification in a format string
+typedef struct
+{
+	const char* start;			// the '%'
+	const char* modifier;		// the length modifier, if any
+	const char* end;			// after the conversion character
+	unsigned int nb_stars;		// number of '*' (width and precision arguments)
+	log_arg_kind_t kind;
+	log_arg_size_t size;
+} log_conversion_t;
+
+
 // ---------- Private variables ---------- //
 
 // The log file
@@ -41,6 +135,33 @@ static volatile sig_atomic_t must_open_log = false;
 // Should we close the log file?
 static volatile sig_atomic_t must_close_log = false;
 
+// Should we exit the main loop?
+static volatile sig_atomic_t must_exit = false;
+
+// Maximum number of messages per second for each level (0 = no limit), and
+// the message counts of the current period
+static unsigned int log_rate = 0;
+static time_t log_rate_period = 0;
+static unsigned int log_rate_counts [MSG_DEBUG + 1];
+static unsigned int log_rate_dropped [MSG_DEBUG + 1];
+static qboolean log_rate_in_line = false;		// the last message didn't end its line
+static qboolean log_rate_line_dropped = false;	// the current line is being dropped
+
+// Asynchronous logging: the main thread writes the records in the ring,
+// the writer thread formats and prints them. There's only one thread on each
+// end of the ring, so the positions are enough to synchronize them
+static qboolean log_async_started = false;
+static qbyte* log_ring = NULL;
+static volatile size_t log_ring_write = 0;		// only modified by the main thread
+static volatile size_t log_ring_read = 0;		// only modified by the writer thread
+static unsigned int log_ring_dropped = 0;
+static volatile qboolean log_writer_stop = false;		// set by the main thread when exiting
+static volatile qboolean log_writer_stopped = false;	// set by the writer thread once the ring is empty
+
+// Outputs of the writer thread
+static FILE* writer_log_file = NULL;
+static qboolean writer_console = false;
+
 
 // ---------- Public variables ---------- //
 
@@ -56,6 +177,9 @@ char peer_address [128];
 // Should we print the date before any new console message?
 qboolean print_date = false;
 
+// Should the console and log outputs be written by a background thread?
+qboolean async_log = false;
+
 // Are port numbers used when computing address hashes?
 qboolean hash_ports = false;
 
@@ -66,15 +190,16 @@ qboolean hash_ports = false;
 ====================
 BuildDateString
 
-Return a string containing the current date and time
+Write a string containing a date and time
 ====================
 */
-static const char* BuildDateString (void)
+static const char* BuildDateString (time_t date, char* datestring, size_t size)
 {
-	static char datestring [80];
+	struct tm local_date;
+	size_t date_len;
 
-	size_t date_len = strftime (datestring, sizeof(datestring),
-								"%Y-%m-%d %H:%M:%S %Z", localtime(&crt_time));
+	Sys_LocalTime (&date, &local_date);
+	date_len = strftime (datestring, size, "%Y-%m-%d %H:%M:%S %Z", &local_date);
 
 	// If the datestring buffer was too small, its contents
 	// is now "indeterminate", so we need to clear it
@@ -85,6 +210,685 @@ static const char* BuildDateString (void)
 }
 
 
+/*
+====================
+Com_NextConversion
+
+Find the next conversion specification in a format string
+====================
+*/
+static qboolean Com_NextConversion (const char* format, log_conversion_t* conv)
+{
+	const char* ptr = strchr (format, '%');
+
+	if (ptr == NULL)
+		return false;
+
+	conv->start = ptr++;
+	conv->nb_stars = 0;
+	conv->size = LOG_SIZE_INT;
+
+	// Flags, width and precision
+	while (*ptr != '\0' && strchr ("-+ #0", *ptr) != NULL)
+		ptr++;
+	if (*ptr == '*')
+	{
+		conv->nb_stars++;
+		ptr++;
+	}
+	else
+		while (isdigit ((unsigned char)*ptr))
+			ptr++;
+	if (*ptr == '.')
+	{
+		ptr++;
+		if (*ptr == '*')
+		{
+			conv->nb_stars++;
+			ptr++;
+		}
+		else
+			while (isdigit ((unsigned char)*ptr))
+				ptr++;
+	}
+
+	// Length modifier
+	conv->modifier = ptr;
+	if (*ptr == 'h')
+	{
+		ptr++;
+		if (*ptr == 'h')
+			ptr++;
+	}
+	else if (*ptr == 'l')
+	{
+		ptr++;
+		conv->size = LOG_SIZE_LONG;
+		if (*ptr == 'l')
+		{
+			ptr++;
+			conv->size = LOG_SIZE_LONGLONG;
+		}
+	}
+	else if (*ptr == 'z')
+	{
+		ptr++;
+		conv->size = LOG_SIZE_SIZET;
+	}
+
+	// Conversion
+	switch (*ptr)
+	{
+		case 'd':
+		case 'i':
+			conv->kind = LOG_ARG_INT;
+			break;
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			conv->kind = LOG_ARG_UINT;
+			break;
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'g':
+		case 'G':
+			conv->kind = LOG_ARG_FLOAT;
+			break;
+		case 'p':
+			conv->kind = LOG_ARG_PTR;
+			break;
+		case 's':
+			conv->kind = LOG_ARG_STRING;
+			break;
+		case 'c':
+			conv->kind = LOG_ARG_CHAR;
+			break;
+		default:
+			conv->kind = LOG_ARG_NONE;
+			break;
+	}
+	if (*ptr != '\0')
+		ptr++;
+
+	conv->end = ptr;
+	return true;
+}
+
+
+/*
+====================
+Com_RingWrite
+
+Copy a record into the log ring. Return "false" if there's not enough room
+====================
+*/
+static qboolean Com_RingWrite (const log_record_t* record, qboolean wait_for_room)
+{
+	assert (record->size % LOG_RECORD_ALIGN == 0);
+	assert (record->size <= LOG_MAX_RECORD_SIZE);
+
+	for (;;)
+	{
+		size_t write_pos = log_ring_write;
+		size_t read_pos = log_ring_read;
+		size_t offset = write_pos & (LOG_RING_SIZE - 1);
+		size_t skip = 0;
+
+		// Make sure the writer thread is done with the space we may reuse
+		Sys_MemoryBarrier ();
+
+		// Records never wrap: skip the end of the ring if necessary
+		if (LOG_RING_SIZE - offset < record->size)
+			skip = LOG_RING_SIZE - offset;
+
+		if ((write_pos - read_pos) + skip + record->size <= LOG_RING_SIZE)
+		{
+			// If the skipped space can hold a record header, mark it as padding
+			// (otherwise, the writer thread will skip it on its own)
+			if (skip >= LOG_HEADER_SIZE)
+			{
+				log_record_t* padding = (log_record_t*)&log_ring[offset];
+
+				padding->size = (unsigned int)skip;
+				padding->type = LOG_RECORD_PADDING;
+			}
+
+			memcpy (&log_ring[(write_pos + skip) & (LOG_RING_SIZE - 1)], record, record->size);
+
+			// Publish the record
+			Sys_MemoryBarrier ();
+			log_ring_write = write_pos + skip + record->size;
+			return true;
+		}
+
+		if (! wait_for_room)
+			return false;
+		Sys_Sleep (1);
+	}
+}
+
+
+/*
+====================
+Com_QueueControl
+
+Queue a record which isn't a message. It's never dropped
+====================
+*/
+static void Com_QueueControl (log_record_type_t type, FILE* file)
+{
+	log_record_t record;
+
+	memset (&record, 0, sizeof (record));
+	record.size = (unsigned int)LOG_HEADER_SIZE;
+	record.type = type;
+	record.date = crt_time;
+	record.file = file;
+
+	Com_RingWrite (&record, true);
+}
+
+
+/*
+====================
+Com_QueueMessage
+
+Store a message and its arguments in the log ring, without formatting it
+====================
+*/
+static void Com_QueueMessage (const char* format, va_list args)
+{
+	static log_arg_t buffer [LOG_MAX_RECORD_SIZE / sizeof (log_arg_t)];
+	log_record_t* record = (log_record_t*)buffer;
+	log_arg_t* record_args = (log_arg_t*)((qbyte*)buffer + LOG_HEADER_SIZE);
+	log_conversion_t conv;
+	const char* ptr;
+	unsigned int nb_args = 0;
+	size_t size;
+
+	// Count the arguments
+	for (ptr = format; Com_NextConversion (ptr, &conv); ptr = conv.end)
+		nb_args += conv.nb_stars + (conv.kind != LOG_ARG_NONE ? 1 : 0);
+	if (nb_args > LOG_MAX_ARGS)
+	{
+		format = "> WARNING: log message with too many arguments\n";
+		nb_args = 0;
+	}
+
+	memset (record, 0, LOG_HEADER_SIZE);
+	record->type = LOG_RECORD_MESSAGE;
+	record->format = format;
+	record->nb_args = nb_args;
+	size = LOG_HEADER_SIZE + nb_args * sizeof (log_arg_t);
+
+	// Read the arguments, and copy the strings after them
+	nb_args = 0;
+	for (ptr = format; record->nb_args > 0 && Com_NextConversion (ptr, &conv); ptr = conv.end)
+	{
+		unsigned int star_ind;
+
+		for (star_ind = 0; star_ind < conv.nb_stars; star_ind++)
+			record_args[nb_args++].int_value = va_arg (args, int);
+
+		switch (conv.kind)
+		{
+			case LOG_ARG_INT:
+				if (conv.size == LOG_SIZE_LONG)
+					record_args[nb_args].int_value = va_arg (args, long);
+				else if (conv.size == LOG_SIZE_LONGLONG)
+					record_args[nb_args].int_value = va_arg (args, long long);
+				else if (conv.size == LOG_SIZE_SIZET)
+					record_args[nb_args].int_value = (long long)va_arg (args, size_t);
+				else
+					record_args[nb_args].int_value = va_arg (args, int);
+				break;
+
+			case LOG_ARG_UINT:
+				if (conv.size == LOG_SIZE_LONG)
+					record_args[nb_args].uint_value = va_arg (args, unsigned long);
+				else if (conv.size == LOG_SIZE_LONGLONG)
+					record_args[nb_args].uint_value = va_arg (args, unsigned long long);
+				else if (conv.size == LOG_SIZE_SIZET)
+					record_args[nb_args].uint_value = va_arg (args, size_t);
+				else
+					record_args[nb_args].uint_value = va_arg (args, unsigned int);
+				break;
+
+			case LOG_ARG_FLOAT:
+				record_args[nb_args].float_value = va_arg (args, double);
+				break;
+
+			case LOG_ARG_PTR:
+				record_args[nb_args].ptr_value = va_arg (args, void*);
+				break;
+
+			case LOG_ARG_CHAR:
+				record_args[nb_args].int_value = va_arg (args, int);
+				break;
+
+			case LOG_ARG_STRING:
+			{
+				const char* string = va_arg (args, const char*);
+
+				// A previous string may have filled the record already
+				if (string != NULL && size + 1 < LOG_MAX_RECORD_SIZE)
+				{
+					size_t length = strlen (string);
+
+					// Truncate the strings which don't fit in the record
+					if (size + length + 1 > LOG_MAX_RECORD_SIZE)
+						length = LOG_MAX_RECORD_SIZE - size - 1;
+
+					memcpy ((qbyte*)buffer + size, string, length);
+					((char*)buffer)[size + length] = '\0';
+					record_args[nb_args].str_value.offset = (unsigned int)size;
+					record_args[nb_args].str_value.length = (unsigned int)length;
+					size += length + 1;
+				}
+				else
+				{
+					record_args[nb_args].str_value.offset = 0;
+					record_args[nb_args].str_value.length = 0;
+				}
+				break;
+			}
+
+			default:
+				continue;
+		}
+
+		nb_args++;
+	}
+	assert (nb_args == record->nb_args);
+
+	record->size = (unsigned int)LOG_ALIGN (size);
+	if (! Com_RingWrite (record, false))
+		log_ring_dropped++;
+}
+
+
+/*
+====================
+Com_FormatMessage
+
+Format a message record. Return the length of the resulting text
+====================
+*/
+static size_t Com_FormatMessage (const log_record_t* record, char* text, size_t text_size)
+{
+	const log_arg_t* record_args = (const log_arg_t*)((const qbyte*)record + LOG_HEADER_SIZE);
+	const char* ptr = record->format;
+	log_conversion_t conv;
+	unsigned int arg_ind = 0;
+	size_t text_len = 0;
+
+	assert (text_size > 0);
+
+	while (text_len < text_size - 1)
+	{
+		char spec [32];
+		size_t spec_len, literal_len;
+		int stars [2];
+		unsigned int star_ind;
+		int result;
+
+		// Copy the text up to the next conversion
+		if (! Com_NextConversion (ptr, &conv))
+		{
+			literal_len = strlen (ptr);
+			if (literal_len > text_size - 1 - text_len)
+				literal_len = text_size - 1 - text_len;
+			memcpy (text + text_len, ptr, literal_len);
+			text_len += literal_len;
+			break;
+		}
+		literal_len = conv.start - ptr;
+		if (literal_len > text_size - 1 - text_len)
+			literal_len = text_size - 1 - text_len;
+		memcpy (text + text_len, ptr, literal_len);
+		text_len += literal_len;
+		ptr = conv.end;
+
+		if (conv.kind == LOG_ARG_NONE)
+		{
+			if (conv.end[-1] == '%' && text_len < text_size - 1)
+				text[text_len++] = '%';
+			continue;
+		}
+
+		// Rebuild the conversion specification, with the length modifier
+		// matching the way we have stored its argument
+		spec_len = conv.modifier - conv.start;
+		if (spec_len + 4 > sizeof (spec))
+			break;
+		memcpy (spec, conv.start, spec_len);
+		if (conv.kind == LOG_ARG_INT || conv.kind == LOG_ARG_UINT)
+		{
+			spec[spec_len++] = 'l';
+			spec[spec_len++] = 'l';
+		}
+		spec[spec_len++] = conv.end[-1];
+		spec[spec_len] = '\0';
+
+		for (star_ind = 0; star_ind < conv.nb_stars; star_ind++)
+			stars[star_ind] = (int)record_args[arg_ind++].int_value;
+
+#define FORMAT_ARG(value)																\
+		(conv.nb_stars == 0 ? snprintf (text + text_len, text_size - text_len, spec, value) :	\
+		 conv.nb_stars == 1 ? snprintf (text + text_len, text_size - text_len, spec, stars[0], value) :	\
+		 snprintf (text + text_len, text_size - text_len, spec, stars[0], stars[1], value))
+
+		switch (conv.kind)
+		{
+			case LOG_ARG_INT:
+				result = FORMAT_ARG (record_args[arg_ind].int_value);
+				break;
+			case LOG_ARG_UINT:
+				result = FORMAT_ARG (record_args[arg_ind].uint_value);
+				break;
+			case LOG_ARG_FLOAT:
+				result = FORMAT_ARG (record_args[arg_ind].float_value);
+				break;
+			case LOG_ARG_PTR:
+				result = FORMAT_ARG (record_args[arg_ind].ptr_value);
+				break;
+			case LOG_ARG_CHAR:
+				result = FORMAT_ARG ((int)record_args[arg_ind].int_value);
+				break;
+			case LOG_ARG_STRING:
+			{
+				const char* string = "(null)";
+
+				if (record_args[arg_ind].str_value.offset != 0)
+					string = (const char*)record + record_args[arg_ind].str_value.offset;
+				result = FORMAT_ARG (string);
+				break;
+			}
+			default:
+				assert (false);
+				result = 0;
+				break;
+		}
+
+#undef FORMAT_ARG
+
+		arg_ind++;
+
+		// Win32's snprintf returns a negative value when the text doesn't fit
+		if (result < 0 || (size_t)result >= text_size - text_len)
+		{
+			text_len = text_size - 1;
+			break;
+		}
+		text_len += result;
+	}
+
+	text[text_len] = '\0';
+	return text_len;
+}
+
+
+/*
+====================
+Com_WriterOutput
+
+Print a text to the outputs of the writer thread
+====================
+*/
+static void Com_WriterOutput (const char* text, size_t length)
+{
+	if (writer_console)
+		fwrite (text, 1, length, stdout);
+	if (writer_log_file != NULL)
+		fwrite (text, 1, length, writer_log_file);
+}
+
+
+/*
+====================
+Com_LogWriter
+
+Main function of the writer thread: format and print the records of the log ring
+====================
+*/
+static void Com_LogWriter (void* arg)
+{
+	static char text [LOG_MAX_RECORD_SIZE * 2];
+	qboolean must_flush = false;
+
+	for (;;)
+	{
+		size_t read_pos = log_ring_read;
+		size_t write_pos = log_ring_write;
+		size_t offset, size;
+
+		// Make sure we see the contents of the records we've been told about
+		Sys_MemoryBarrier ();
+
+		if (read_pos == write_pos)
+		{
+			if (must_flush)
+			{
+				if (writer_console)
+					fflush (stdout);
+				if (writer_log_file != NULL)
+					fflush (writer_log_file);
+				must_flush = false;
+			}
+
+			// Everything has been printed and flushed, we can stop now
+			if (log_writer_stop)
+			{
+				log_writer_stopped = true;
+				return;
+			}
+
+			Sys_Sleep (LOG_WRITER_SLEEP);
+			continue;
+		}
+
+		offset = read_pos & (LOG_RING_SIZE - 1);
+
+		// Too small to hold a record: that's the end of the ring
+		if (LOG_RING_SIZE - offset < LOG_HEADER_SIZE)
+			size = LOG_RING_SIZE - offset;
+		else
+		{
+			const log_record_t* record = (const log_record_t*)&log_ring[offset];
+			char datestring [80];
+			size_t length;
+
+			size = record->size;
+			switch (record->type)
+			{
+				case LOG_RECORD_MESSAGE:
+					length = Com_FormatMessage (record, text, sizeof (text));
+					Com_WriterOutput (text, length);
+					break;
+
+				case LOG_RECORD_DATE:
+					BuildDateString (record->date, datestring, sizeof (datestring));
+					length = snprintf (text, sizeof (text), "\n* %s\n", datestring);
+					Com_WriterOutput (text, length);
+					break;
+
+				case LOG_RECORD_SET_FILE:
+					BuildDateString (record->date, datestring, sizeof (datestring));
+					if (writer_log_file != NULL)
+					{
+						fprintf (writer_log_file, "\n> Closing log file (time: %s)\n", datestring);
+						fclose (writer_log_file);
+					}
+					writer_log_file = record->file;
+					if (writer_log_file != NULL)
+						fprintf (writer_log_file, "> Opening log file (time: %s)\n", datestring);
+					break;
+
+				default:
+					assert (record->type == LOG_RECORD_PADDING);
+					break;
+			}
+		}
+
+		// Release the space used by this record
+		Sys_MemoryBarrier ();
+		log_ring_read = read_pos + size;
+		must_flush = true;
+	}
+}
+
+
+static void Com_Output (const char* format, ...);
+
+
+/*
+====================
+Com_VOutput
+
+Print a message to the console and the log file, or queue it for the writer thread
+====================
+*/
+static void Com_VOutput (const char* format, va_list args)
+{
+	// The writer thread will do the formatting and the printing
+	if (log_async_started)
+	{
+		if (print_date)
+		{
+			Com_QueueControl (LOG_RECORD_DATE, NULL);
+			print_date = false;
+		}
+
+		// Report the messages we couldn't queue, as soon as there's room again
+		if (log_ring_dropped > 0)
+		{
+			unsigned int nb_dropped = log_ring_dropped;
+
+			log_ring_dropped = 0;
+			Com_Output ("> WARNING: %u message(s) dropped (log ring full)\n", nb_dropped);
+		}
+
+		Com_QueueMessage (format, args);
+		return;
+	}
+
+	// Print a time stamp if necessary
+	if (print_date)
+	{
+		char datestring [80];
+
+		BuildDateString (crt_time, datestring, sizeof (datestring));
+
+		if (daemon_state < DAEMON_STATE_EFFECTIVE)
+			printf ("\n* %s\n", datestring);
+		if (log_file != NULL)
+			fprintf (log_file, "\n* %s\n", datestring);
+
+		print_date = false;
+	}
+
+	if (daemon_state < DAEMON_STATE_EFFECTIVE)
+	{
+		va_list args_copy;
+
+		va_copy (args_copy, args);
+		vprintf (format, args_copy);
+		va_end (args_copy);
+	}
+	if (log_file != NULL)
+		vfprintf (log_file, format, args);
+}
+
+
+/*
+====================
+Com_Output
+
+Print a message without checking its level nor the log rate limit
+====================
+*/
+static void Com_Output (const char* format, ...)
+{
+	va_list args;
+
+	va_start (args, format);
+	Com_VOutput (format, args);
+	va_end (args);
+}
+
+
+/*
+====================
+Com_ReportLogRateDrops
+
+Report the messages dropped by the log rate limit since the last report
+====================
+*/
+static void Com_ReportLogRateDrops (void)
+{
+	int level;
+
+	// Printed directly, so the report itself isn't subject to the rate limit
+	for (level = MSG_WARNING; level <= MSG_DEBUG; level++)
+		if (log_rate_dropped[level] > 0)
+		{
+			Com_Output ("> %u message(s) of level %d dropped by the log rate limit\n",
+						log_rate_dropped[level], level);
+			log_rate_dropped[level] = 0;
+		}
+}
+
+
+/*
+====================
+Com_CheckLogRate
+
+Return "false" if a message must be dropped because of the rate limit
+====================
+*/
+static qboolean Com_CheckLogRate (msg_level_t msg_level, const char* format)
+{
+	size_t format_len;
+
+	if (log_rate == 0)
+		return true;
+
+	// Messages are often printed in several pieces: the whole line gets
+	// dropped or printed, depending on its first piece
+	if (! log_rate_in_line)
+	{
+		// New period: report the messages we have dropped during the previous one
+		if (crt_time != log_rate_period)
+		{
+			Com_ReportLogRateDrops ();
+			memset (log_rate_counts, 0, sizeof (log_rate_counts));
+			log_rate_period = crt_time;
+		}
+
+		// Errors are never dropped
+		if (msg_level <= MSG_ERROR)
+			log_rate_line_dropped = false;
+		else if (log_rate_counts[msg_level] >= log_rate)
+		{
+			log_rate_dropped[msg_level]++;
+			log_rate_line_dropped = true;
+		}
+		else
+		{
+			log_rate_counts[msg_level]++;
+			log_rate_line_dropped = false;
+		}
+	}
+
+	format_len = strlen (format);
+	log_rate_in_line = (format_len > 0 && format[format_len - 1] != '\n');
+
+	return ! log_rate_line_dropped;
+}
+
+
 /*
 ====================
 CloseLogFile
@@ -92,15 +896,22 @@ CloseLogFile
 Close the log file
 ====================
 */
-static void CloseLogFile (const char* datestring)
+static void CloseLogFile (void)
 {
 	if (log_file != NULL)
 	{
-		if (datestring == NULL)
-			datestring = BuildDateString();
+		// The writer thread owns the log file
+		if (log_async_started)
+			Com_QueueControl (LOG_RECORD_SET_FILE, NULL);
+		else
+		{
+			char datestring [80];
+
+			BuildDateString (crt_time, datestring, sizeof (datestring));
+			fprintf (log_file, "\n> Closing log file (time: %s)\n", datestring);
+			fclose (log_file);
+		}
 
-		fprintf (log_file, "\n> Closing log file (time: %s)\n", datestring);
-		fclose (log_file);
 		log_file = NULL;
 	}
 }
@@ -130,7 +941,9 @@ Enable the logging
 */
 void Com_FlushLog (void)
 {
-	fflush (log_file);
+	// The writer thread flushes the log file on its own
+	if (! log_async_started)
+		fflush (log_file);
 }
 
 
@@ -178,12 +991,9 @@ qboolean Com_UpdateLogStatus (qboolean init)
 	// If we need to (re)open the log file
 	if (must_open_log)
 	{
-		const char* datestring;
-
 		must_open_log = false;
 
-		datestring = BuildDateString ();
-		CloseLogFile (datestring);
+		CloseLogFile ();
 
 		log_file = fopen (log_filepath, "a");
 		if (log_file == NULL)
@@ -196,7 +1006,16 @@ qboolean Com_UpdateLogStatus (qboolean init)
 		// Make the log stream fully buffered (instead of line buffered)
 		setvbuf (log_file, NULL, _IOFBF, SETVBUF_DEFAULT_SIZE);
 
-		fprintf (log_file, "> Opening log file (time: %s)\n", datestring);
+		// Give it to the writer thread, if any
+		if (log_async_started)
+			Com_QueueControl (LOG_RECORD_SET_FILE, log_file);
+		else
+		{
+			char datestring [80];
+
+			BuildDateString (crt_time, datestring, sizeof (datestring));
+			fprintf (log_file, "> Opening log file (time: %s)\n", datestring);
+		}
 
 		// if we're opening the log after the initialization, print the list of servers
 		if (! init)
@@ -208,13 +1027,107 @@ qboolean Com_UpdateLogStatus (qboolean init)
 	if (must_close_log)
 	{
 		must_close_log = false;
-		CloseLogFile (NULL);
+		CloseLogFile ();
+	}
+
+	return true;
+}
+
+
+/*
+====================
+Com_SetLogRate
+
+Set the maximum number of messages printed per second for each message level (errors excepted)
+====================
+*/
+qboolean Com_SetLogRate (unsigned int max_per_second)
+{
+	log_rate = max_per_second;
+	return true;
+}
+
+
+/*
+====================
+Com_StartAsyncLog
+
+Write the console and log messages from a background thread from now on
+====================
+*/
+qboolean Com_StartAsyncLog (void)
+{
+	assert (! log_async_started);
+
+	log_ring = malloc (LOG_RING_SIZE);
+	if (log_ring == NULL)
+	{
+		Com_Printf (MSG_ERROR,
+					"> ERROR: can't allocate the log ring (%s)\n",
+					strerror (errno));
+		return false;
 	}
 
+	// Hand the outputs over to the writer thread
+	fflush (stdout);
+	if (log_file != NULL)
+		fflush (log_file);
+	writer_log_file = log_file;
+	writer_console = (daemon_state < DAEMON_STATE_EFFECTIVE);
+
+	if (! Sys_CreateThread (Com_LogWriter, NULL))
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: can't start the log writer thread\n");
+		free (log_ring);
+		log_ring = NULL;
+		return false;
+	}
+	log_async_started = true;
+
+	// Print what's left in the ring when we exit
+	atexit (Com_StopAsyncLog);
+
+	Com_Printf (MSG_NORMAL, "> Asynchronous logging enabled\n");
 	return true;
 }
 
 
+/*
+====================
+Com_StopAsyncLog
+
+Wait for the writer thread to print the queued messages, and write them directly from now on
+====================
+*/
+void Com_StopAsyncLog (void)
+{
+	unsigned int waited;
+
+	if (! log_async_started)
+		return;
+
+	Com_ReportLogRateDrops ();
+	if (log_ring_dropped > 0)
+	{
+		Com_Output ("> WARNING: %u message(s) dropped (log ring full)\n", log_ring_dropped);
+		log_ring_dropped = 0;
+	}
+
+	log_writer_stop = true;
+	for (waited = 0; ! log_writer_stopped && waited < LOG_STOP_TIMEOUT; waited += LOG_WRITER_SLEEP)
+		Sys_Sleep (LOG_WRITER_SLEEP);
+
+	// If the writer is stuck, leave the ring and the outputs to it
+	if (! log_writer_stopped)
+		return;
+
+	Sys_MemoryBarrier ();
+	log_async_started = false;
+	free (log_ring);
+	log_ring = NULL;
+}
+
+
 // ---------- Public functions (user hash table) ---------- //
 
 /*
@@ -300,41 +1213,33 @@ Print a message to screen, depending on its verbose level
 */
 void Com_Printf (msg_level_t msg_level, const char* format, ...)
 {
+	va_list args;
+
 	// If the message level is above the maximum level, or if we output
 	// neither to the console nor to a log file, there nothing to do
 	if (msg_level > max_msg_level ||
 		(log_file == NULL && daemon_state == DAEMON_STATE_EFFECTIVE))
 		return;
 
-	// Print a time stamp if necessary
-	if (print_date)
-	{
-		const char* datestring = BuildDateString();
-
-		if (daemon_state < DAEMON_STATE_EFFECTIVE)
-			printf ("\n* %s\n", datestring);
-		if (log_file != NULL)
-			fprintf (log_file, "\n* %s\n", datestring);
+	if (! Com_CheckLogRate (msg_level, format))
+		return;
 
-		print_date = false;
-	}
+	va_start (args, format);
+	Com_VOutput (format, args);
+	va_end (args);
+}
 
-	if (daemon_state < DAEMON_STATE_EFFECTIVE)
-	{
-		va_list args;
 
-		va_start (args, format);
-		vprintf (format, args);
-		va_end (args);
-	}
-	if (log_file != NULL)
-	{
-		va_list args;
+/*
+====================
+Com_IsExitRequested
 
-		va_start (args, format);
-		vfprintf (log_file, format, args);
-		va_end (args);
-	}
+Test if we've been asked to exit
+====================
+*/
+qboolean Com_IsExitRequested (void)
+{
+	return (must_exit != 0);
 }
 
 
@@ -359,6 +1264,15 @@ void Com_SignalHandler (int Signal)
 			must_close_log = true;
 			break;
 #endif
+#ifdef SIGHUP
+		case SIGHUP:
+			Sv_RequestAddressMappingsReload ();
+			break;
+#endif
+		case SIGINT:
+		case SIGTERM:
+			must_exit = true;
+			break;
 		default:
 			// We aren't suppose to be here...
 			assert(false);
@@ -136,6 +136,9 @@ extern char peer_address [128];
 // Should we print the date before any new console message?
 extern qboolean print_date;
 
+// Should the console and log outputs be written by a background thread?
+extern qboolean async_log;
+
 // Are port numbers used when computing address hashes?
 extern qboolean hash_ports;
 
@@ -171,12 +174,24 @@ qboolean Com_SetLogFilePath (const char* filepath);
 // Update the logging status, opening or closing the log file when necessary
 qboolean Com_UpdateLogStatus (qboolean init);
 
+// Set the maximum number of messages printed per second for each message level (errors excepted)
+qboolean Com_SetLogRate (unsigned int max_per_second);
+
+// Write the console and log messages from a background thread from now on
+qboolean Com_StartAsyncLog (void);
+
+// Print the messages still queued for the writer thread, and stop it
+void Com_StopAsyncLog (void);
+
 
 // ---------- Public functions (misc) ---------- //
 
 // Print a text to the screen and/or to the log file
 void Com_Printf (msg_level_t msg_level, const char* format, ...);
 
+// Test if we've been asked to exit (SIGINT or SIGTERM)
+qboolean Com_IsExitRequested (void);
+
 // Handling of the signals sent to this process
 void Com_SignalHandler (int Signal);
 
@@ -25,6 +25,7 @@
 #include "common.h"
 #include "system.h"
 
+#include "challenges.h"
 #include "clients.h"
 #include "games.h"
 #include "messages.h"
@@ -52,6 +53,15 @@ static const cmdlineopt_t cmdline_options [] =
 		0,
 		0
 	},
+	{
+		"async-log",
+		NULL,
+		"Format and write the console and log messages from a background thread",
+		{ 0, 0 },
+		'\0',
+		0,
+		0
+	},
 	{
 		"cl-hash-size",
 		"<hash_size>",
@@ -166,11 +176,23 @@ static const cmdlineopt_t cmdline_options [] =
 		1,
 		1
 	},
+	{
+		"log-rate",
+		"<max_messages>",
+		"Print at most <max_messages> messages per second for each\n"
+		"   verbosity level, errors excepted (default: 0, no limit)",
+		{ 0, 0 },
+		'\0',
+		1,
+		1
+	},
 	{
 		"map",
 		"<a1>=<a2>",
 		"Map IPv4 address <a1> to IPv4 address <a2> when sending it to clients\n"
-		"   Addresses can contain a port number (ex: myaddr.net:1234)",
+		"   Addresses can contain a port number (ex: myaddr.net:1234)\n"
+		"   <a1> can also be a subnet, without port number (ex: 10.0.0.0/24)\n"
+		"   The mappings are resolved again when dpmaster receives a SIGHUP",
 		{ 0, 0 },
 		'm',
 		1,
@@ -213,6 +235,16 @@ static const cmdlineopt_t cmdline_options [] =
 		1,
 		1
 	},
+	{
+		"stateless-challenges",
+		NULL,
+		"Don't record servers before they answer their challenge, to resist\n"
+		"   heartbeat floods from spoofed addresses",
+		{ 0, 0 },
+		'\0',
+		0,
+		0
+	},
 	{
 		"verbose",
 		"[verbose_lvl]",
@@ -332,6 +364,10 @@ static cmdline_status_t Cmdline_Option (const cmdlineopt_t* opt, const char** pa
 	if (strcmp (opt_name, "allow-loopback") == 0)
 		allow_loopback = true;
 
+	// Asynchronous logging
+	else if (strcmp (opt_name, "async-log") == 0)
+		async_log = true;
+
 	// Flood protection
 	else if (strcmp (opt_name, "flood-protection") == 0)
 		flood_protection = true;
@@ -447,6 +483,22 @@ static cmdline_status_t Cmdline_Option (const cmdlineopt_t* opt, const char** pa
 			return CMDLINE_STATUS_INVALID_OPT_PARAMS;
 	}
 
+	// Log rate
+	else if (strcmp (opt_name, "log-rate") == 0)
+	{
+		const char* start_ptr;
+		char* end_ptr;
+		unsigned int max_per_second;
+
+		start_ptr = params[0];
+		max_per_second = (unsigned int)strtol (start_ptr, &end_ptr, 0);
+		if (end_ptr == start_ptr || *end_ptr != '\0')
+			return CMDLINE_STATUS_INVALID_OPT_PARAMS;
+
+		if (! Com_SetLogRate (max_per_second))
+			return CMDLINE_STATUS_INVALID_OPT_PARAMS;
+	}
+
 	// Address mapping
 	else if (strcmp (opt_name, "map") == 0)
 	{
@@ -517,6 +569,10 @@ static cmdline_status_t Cmdline_Option (const cmdlineopt_t* opt, const char** pa
 		master_port = port_num;
 	}
 
+	// Stateless challenges
+	else if (strcmp (opt_name, "stateless-challenges") == 0)
+		stateless_challenges = true;
+
 	// Verbose level
 	else if (strcmp (opt_name, "verbose") == 0)
 	{
@@ -911,6 +967,22 @@ static qboolean SecureInit (void)
 		return false;
 	}
 #endif
+#ifdef SIGHUP
+	if (signal (SIGHUP, Com_SignalHandler) == SIG_ERR)
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: can't capture the SIGHUP signal\n");
+		return false;
+	}
+#endif
+#ifndef WIN32
+	// Exit the main loop normally, so the queued log messages get printed
+	if (signal (SIGINT, Com_SignalHandler) == SIG_ERR ||
+		signal (SIGTERM, Com_SignalHandler) == SIG_ERR)
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: can't capture the SIGINT and SIGTERM signals\n");
+		return false;
+	}
+#endif
 
 	if (! Sys_CreateListenSockets ())
 		return false;
@@ -930,6 +1002,14 @@ static qboolean SecureInit (void)
 	if (! Cl_Init ())
 		return false;
 
+	// Generate the secret used to build the challenges
+	if (! Ch_Init ())
+		return false;
+
+	// From now on, let a background thread write the console and log messages
+	if (async_log && ! Com_StartAsyncLog ())
+		return false;
+
 	return true;
 }
 
@@ -988,8 +1068,8 @@ int main (int argc, const char* argv [])
 		! Sys_SecureInit () || ! SecureInit ())
 		return EXIT_FAILURE;
 
-	// Until the end of times...
-	for (;;)
+	// Until the end of times... or until we're asked to exit
+	while (! Com_IsExitRequested ())
 	{
 		fd_set sock_set;
 		socket_t max_sock;
@@ -1007,6 +1087,9 @@ int main (int argc, const char* argv [])
 				max_sock = crt_sock;
 		}
 
+		// Resolve the address mappings again if we've been asked to
+		Sv_UpdateAddressMappings ();
+
 		// Flush the console and log file
 		if (Com_IsLogEnabled ())
 			Com_FlushLog ();
@@ -1018,6 +1101,9 @@ int main (int argc, const char* argv [])
 		// Update the current time
 		crt_time = time (NULL);
 
+		if (Com_IsExitRequested ())
+			break;
+
 		print_date = false;
 		Com_UpdateLogStatus (false);
 
@@ -1113,4 +1199,8 @@ int main (int argc, const char* argv [])
 			HandleMessage (packet + 4, nb_bytes - 4, &address, addrlen, crt_sock);
 		}
 	}
+
+	// The asynchronous log, if any, is emptied by an exit handler
+	Com_Printf (MSG_NORMAL, "> Exiting\n");
+	return EXIT_SUCCESS;
 }
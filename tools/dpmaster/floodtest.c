@@ -0,0 +1,159 @@
+/*
+	floodtest.c
+
+	Stress test for the dpmaster flood protection
+
+	Replays a flood of queries from spoofed sources, interleaved with the
+	queries of a set of well-behaved clients, through the client throttle,
+	and reports how many queries of each kind the master would answer
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+
+#include "common.h"
+#include "system.h"
+#include "clients.h"
+
+
+// ---------- Constants ---------- //
+
+// Simulated duration, in seconds. The flood starts once the good clients are known
+#define TEST_DURATION 120
+#define WARMUP_DURATION GOOD_CLIENT_PERIOD
+
+// Number of spoofed queries per second, each from a new source
+#define FLOOD_RATE 20000
+
+// Number of well-behaved clients, and the delay between two of their queries
+#define NB_GOOD_CLIENTS 64
+#define GOOD_CLIENT_PERIOD 4
+
+
+// ---------- Private functions ---------- //
+
+/*
+====================
+Ft_MakeAddress
+
+Build an IPv4 address from a 32-bit number
+====================
+*/
+static socklen_t Ft_MakeAddress (struct sockaddr_storage* addr, unsigned int ip)
+{
+	struct sockaddr_in* addr_in = (struct sockaddr_in*)addr;
+
+	memset (addr, 0, sizeof (*addr));
+	addr_in->sin_family = AF_INET;
+	addr_in->sin_addr.s_addr = htonl (ip);
+	addr_in->sin_port = htons (27960);
+	return sizeof (*addr_in);
+}
+
+
+/*
+====================
+Ft_Query
+
+Send one query through the throttle. Return "true" if it would be answered
+====================
+*/
+static qboolean Ft_Query (unsigned int ip)
+{
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+
+	addrlen = Ft_MakeAddress (&addr, ip);
+	return ! Cl_BlockedByThrottle (&addr, addrlen);
+}
+
+
+// ---------- Public functions ---------- //
+
+/*
+====================
+main
+
+Entry point
+====================
+*/
+int main (int argc, const char* argv [])
+{
+	unsigned int good_sent = 0, good_answered = 0;
+	unsigned int flood_answered = 0;
+	unsigned int spoofed_ip = 0x0A000000;	// 10.0.0.0/8, disjoint from the good clients
+	unsigned int second;
+	clock_t start, elapsed;
+
+	max_msg_level = MSG_NOPRINT;
+	flood_protection = true;
+	crt_time = 1;
+	if (! Cl_Init ())
+		return EXIT_FAILURE;
+
+	start = clock ();
+	for (second = 0; second < WARMUP_DURATION + TEST_DURATION; second++)
+	{
+		unsigned int ind;
+		qboolean flooding = (second >= WARMUP_DURATION);
+
+		crt_time++;
+
+		for (ind = 0; ind < FLOOD_RATE; ind++)
+		{
+			// Spread the good clients' queries over the second
+			if (ind % (FLOOD_RATE / NB_GOOD_CLIENTS) == 0)
+			{
+				unsigned int good_ind = ind / (FLOOD_RATE / NB_GOOD_CLIENTS);
+
+				if (good_ind < NB_GOOD_CLIENTS &&
+					(second + good_ind) % GOOD_CLIENT_PERIOD == 0)
+				{
+					qboolean answered = Ft_Query (0xC0A80001 + good_ind);
+
+					if (flooding)
+					{
+						good_sent++;
+						if (answered)
+							good_answered++;
+					}
+				}
+			}
+
+			if (flooding && Ft_Query (spoofed_ip++))
+				flood_answered++;
+		}
+	}
+	elapsed = clock () - start;
+
+	printf ("Simulated %u seconds at %u spoofed queries/s with %u good clients\n",
+			TEST_DURATION, FLOOD_RATE, NB_GOOD_CLIENTS);
+	printf ("  - good client queries answered: %u / %u (%.1f%%)\n",
+			good_answered, good_sent, 100.0 * good_answered / good_sent);
+	printf ("  - spoofed queries answered: %u / %u (%.1f per second)\n",
+			flood_answered, TEST_DURATION * FLOOD_RATE,
+			(double)flood_answered / TEST_DURATION);
+	// The warm-up queries are timed too, but they are negligible
+	printf ("  - throttle throughput: %.0f queries per CPU second\n",
+			(double)(TEST_DURATION * FLOOD_RATE + good_sent) * CLOCKS_PER_SEC / (elapsed ? elapsed : 1));
+
+	// A few good clients may be pushed out when the flood starts filling the
+	// table, but the others must keep being served while nearly all of the
+	// spoofed queries are refused
+	if (good_answered * 100 < good_sent * 95 ||
+		flood_answered * 100 > TEST_DURATION * FLOOD_RATE)
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
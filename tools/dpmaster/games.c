@@ -793,6 +793,64 @@ const game_properties_t* Game_GetPropertiesByHeartbeat (const char* heartbeat_ta
 }
 
 
+/*
+====================
+Game_GetPropertiesIndex
+
+Returns the index of a game in the game properties list (0 is reserved for NULL)
+====================
+*/
+unsigned int Game_GetPropertiesIndex (const game_properties_t* game_props)
+{
+	const game_properties_t* props = game_properties_list;
+	unsigned int index = 1;
+
+	if (game_props == NULL)
+		return 0;
+
+	while (props != NULL)
+	{
+		if (props == game_props)
+			return index;
+
+		props = props->next;
+		index++;
+	}
+
+	// We aren't suppose to be here...
+	assert (false);
+	return 0;
+}
+
+
+/*
+====================
+Game_GetPropertiesByIndex
+
+Returns the properties of a game using its index in the game properties list
+====================
+*/
+const game_properties_t* Game_GetPropertiesByIndex (unsigned int index, qboolean* valid_index)
+{
+	const game_properties_t* props = game_properties_list;
+
+	*valid_index = true;
+	if (index == 0)
+		return NULL;
+
+	while (props != NULL)
+	{
+		if (--index == 0)
+			return props;
+
+		props = props->next;
+	}
+
+	*valid_index = false;
+	return NULL;
+}
+
+
 /*
 ====================
 Game_GetOptions
@@ -94,5 +94,12 @@ const game_properties_t* Game_GetPropertiesByHeartbeat (const char* heartbeat_ta
 // Returns the options of a game
 game_options_t Game_GetOptions (const char* game);
 
+// Returns the index of a game in the game properties list (0 is reserved for NULL)
+unsigned int Game_GetPropertiesIndex (const game_properties_t* game_props);
+
+// Returns the properties of a game using its index in the game properties list.
+// "valid_index" will be set to "false" if no game uses this index
+const game_properties_t* Game_GetPropertiesByIndex (unsigned int index, qboolean* valid_index);
+
 
 #endif  // #ifndef _GAMES_H_
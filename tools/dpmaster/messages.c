@@ -24,6 +24,7 @@
 #include "common.h"
 #include "system.h"
 
+#include "challenges.h"
 #include "clients.h"
 #include "games.h"
 #include "messages.h"
@@ -35,9 +36,6 @@
 // Timeout after a valid infoResponse (in secondes)
 #define TIMEOUT_INFORESPONSE (15 * 60)
 
-// Period of validity for a challenge string (in secondes)
-#define TIMEOUT_CHALLENGE 5
-
 // Maximum size of a reponse packet
 #define MAX_PACKET_SIZE_OUT 1400
 
@@ -66,6 +64,7 @@
 
 // DP: "getserversExt DarkPlaces-Quake 3 empty full ipv4 ipv6"
 // IOQuake3: "getserversExt 68 empty ipv6"
+// IW5M: "getserversExt IW5 19816 full empty mapname=mp_dome clients>=4"
 #define C2M_GETSERVERSEXT "getserversExt "
 
 // Q3 & DP & QFusion:
@@ -172,38 +171,6 @@ static const char* SearchInfostring (const char* infostring, const char* key)
 }
 
 
-/*
-====================
-BuildChallenge
-
-Build a challenge string for a "getinfo" message
-====================
-*/
-static const char* BuildChallenge (void)
-{
-	static char challenge [CHALLENGE_MAX_LENGTH];
-	size_t ind;
-	size_t length = CHALLENGE_MIN_LENGTH - 1;  // We start at the minimum size
-
-	// ... then we add a random number of characters
-	length += rand () % (CHALLENGE_MAX_LENGTH - CHALLENGE_MIN_LENGTH + 1);
-
-	for (ind = 0; ind < length; ind++)
-	{
-		char c;
-		do
-		{
-			c = 33 + rand () % (126 - 33 + 1);  // -> c = 33..126
-		} while (c == '\\' || c == ';' || c == '"' || c == '%' || c == '/');
-
-		challenge[ind] = c;
-	}
-
-	challenge[length] = '\0';
-	return challenge;
-}
-
-
 /*
 ====================
 SendGetInfo
@@ -211,31 +178,25 @@ SendGetInfo
 Send a "getinfo" message to a server
 ====================
 */
-static void SendGetInfo (server_t* server, socket_t recv_socket, qboolean force_new_challenge)
+static void SendGetInfo (const struct sockaddr_storage* addr, socklen_t addrlen, socket_t recv_socket,
+						 const game_properties_t* game_props, unsigned short alt_port)
 {
 	char msg [64] = "\xFF\xFF\xFF\xFF" M2S_GETINFO " ";
+	const char* challenge;
 	size_t msglen;
 
-	if (force_new_challenge || !server->challenge_timeout || server->challenge_timeout < crt_time)
-	{
-		const char* challenge;
-
-		challenge = BuildChallenge ();
-		strncpy (server->challenge, challenge, sizeof (server->challenge) - 1);
-		server->challenge_timeout = crt_time + TIMEOUT_CHALLENGE;
-	}
+	challenge = Ch_Build (addr, game_props, alt_port);
 
 	msglen = strlen (msg);
-	strncpy (msg + msglen, server->challenge, sizeof (msg) - msglen - 1);
+	strncpy (msg + msglen, challenge, sizeof (msg) - msglen - 1);
 	msg[sizeof (msg) - 1] = '\0';
 	if (sendto (recv_socket, msg, strlen (msg), 0,
-				(const struct sockaddr*)&server->user.address,
-				server->user.addrlen) < 0)
+				(const struct sockaddr*)addr, addrlen) < 0)
 		Com_Printf (MSG_WARNING, "> WARNING: can't send getinfo (%s)\n",
 					Sys_GetLastNetErrorString ());
 	else
 		Com_Printf (MSG_NORMAL, "> %s <--- getinfo with challenge \"%s\"\n",
-					peer_address, server->challenge);
+					peer_address, challenge);
 }
 
 
@@ -249,9 +210,8 @@ Parse heartbeat requests
 static void HandleHeartbeat (const char* msg, const struct sockaddr_storage* addr, socklen_t addrlen, socket_t recv_socket, qboolean extended)
 {
 	char tag [64];
-	unsigned short altPort;
+	unsigned short altPort = 0;
 	const game_properties_t* game_props;
-	server_t* server;
 	qboolean flatlineHeartbeat;
 
 	// Extract the tag
@@ -304,28 +264,20 @@ static void HandleHeartbeat (const char* msg, const struct sockaddr_storage* add
 	else
 		game_props = NULL;
 
-	// Get the server in the list (add it to the list if necessary)
-	server = Sv_GetByAddr (addr, addrlen, true);
-	if (server == NULL)
-		return;
-
-	assert (server->state != sv_state_unused_slot);
-
-	if (extended)
-	{
-		server->user.altPort = altPort;
-	}
-	else
+	// Get the server in the list (add it to the list if necessary).
+	// In stateless mode, only a valid infoResponse can add a server
+	if (! stateless_challenges)
 	{
-		server->user.altPort = 0;
-	}
+		server_t* server = Sv_GetByAddr (addr, addrlen, true);
+		if (server == NULL)
+			return;
 
-	// Ask for some infos.
-	// Force a new challenge if the heartbeat tag has changed
-	SendGetInfo (server, recv_socket, server->hb_properties != game_props);
+		assert (server->state != sv_state_unused_slot);
+	}
 
-	// Save the game properties for a future use
-	server->hb_properties = game_props;
+	// Ask for some infos. The game properties and the alternate
+	// port are embedded in the challenge, we'll get them back later
+	SendGetInfo (addr, addrlen, recv_socket, game_props, altPort);
 }
 
 
@@ -355,6 +307,8 @@ static void HandleGetServers (const char* msg, const struct sockaddr_storage* ad
 	qboolean opt_ipv4 = (! extended_request);
 	qboolean opt_ipv6 = false;
 	qboolean opt_gametype = false;
+	server_filter_t filters [MAX_INFO_FILTERS];
+	unsigned int nb_filters = 0;
 	char filter_options [MAX_PACKET_SIZE_IN];
 	char* option_ptr;
 	unsigned int nb_servers;
@@ -498,6 +452,21 @@ static void HandleGetServers (const char* msg, const struct sockaddr_storage* ad
 				opt_ipv4 = true;
 			else if (strcmp (option_ptr, "ipv6") == 0)
 				opt_ipv6 = true;
+
+			// Infostring filter. A filter we can't apply must not widen
+			// the result to the full list, so the request is refused
+			else if (strpbrk (option_ptr, "=<>!") != NULL)
+			{
+				if (nb_filters >= MAX_INFO_FILTERS ||
+					! Sv_ParseFilter (option_ptr, &filters[nb_filters]))
+				{
+					Com_Printf (MSG_WARNING,
+								"> WARNING: Rejecting %s from %s (invalid or too many filters, \"%s\")\n",
+								request_name, peer_address, option_ptr);
+					return;
+				}
+				nb_filters++;
+			}
 		}
 		option_ptr = strtok (NULL, " ");
 	}
@@ -553,6 +522,8 @@ static void HandleGetServers (const char* msg, const struct sockaddr_storage* ad
 				Com_Printf (MSG_DEBUG,
 							"    Reject: gametype \"%s\" != requested \"%s\"\n",
 							sv->gametype, gametype);
+			else if (! Sv_MatchFilters (sv, filters, nb_filters))
+				Com_Printf (MSG_DEBUG, "    Reject: infostring filters not matched\n");
 			else
 			{
 				if (gamename[0] != '\0')
@@ -606,7 +577,8 @@ static void HandleGetServers (const char* msg, const struct sockaddr_storage* ad
 			(! opt_ipv4 && sv->user.address.ss_family == AF_INET) ||
 			(! opt_ipv6 && sv->user.address.ss_family == AF_INET6) ||
 			(opt_gametype && strcmp (gametype, sv->gametype) != 0) ||
-			strcmp (gamename, sv->gamename) != 0)
+			strcmp (gamename, sv->gamename) != 0 ||
+			! Sv_MatchFilters (sv, filters, nb_filters))
 		{
 			// Skip it
 			continue;
@@ -761,27 +733,26 @@ HandleInfoResponse
 Parse infoResponse messages
 ====================
 */
-static void HandleInfoResponse (server_t* server, const char* msg)
+static void HandleInfoResponse (const char* msg, const struct sockaddr_storage* addr, socklen_t addrlen)
 {
+	server_t* server;
+	const game_properties_t* hb_properties;
+	unsigned short alt_port;
 	const char* value;
 	int new_protocol;
 	char new_gametype [GAMETYPE_LENGTH];
 	char* end_ptr;
 	unsigned int new_maxclients, new_clients;
+	char new_mapname [MAPNAME_LENGTH];
+	char new_hostname [256];
+	server_info_t info;
 
-	// Check the challenge
-	if (!server->challenge_timeout || server->challenge_timeout < crt_time)
-	{
-		Com_Printf (MSG_WARNING,
-					"> WARNING: infoResponse with obsolete challenge from %s\n",
-					peer_address);
-		return;
-	}
+	// Check the challenge, and get back the heartbeat informations it contains
 	value = SearchInfostring (msg, "challenge");
-	if (!value || strcmp (value, server->challenge))
+	if (value == NULL || ! Ch_Check (value, addr, &hb_properties, &alt_port))
 	{
-		Com_Printf (MSG_WARNING, "> WARNING: invalid challenge from %s (%s)\n",
-					peer_address, value);
+		Com_Printf (MSG_WARNING, "> WARNING: invalid or obsolete challenge from %s (%s)\n",
+					peer_address, (value != NULL ? value : ""));
 		return;
 	}
 
@@ -850,7 +821,7 @@ static void HandleInfoResponse (server_t* server, const char* msg)
 	if (value == NULL)
 	{
 		// Games that neither send a known heartbeat nor provide a game name are ignored
-		if (server->hb_properties == NULL)
+		if (hb_properties == NULL)
 		{
 			Com_Printf (MSG_WARNING,
 						"> WARNING: invalid infoResponse from %s (no game name)\n",
@@ -858,13 +829,13 @@ static void HandleInfoResponse (server_t* server, const char* msg)
 			return;
 		}
 		
-		value = server->hb_properties->name;
+		value = hb_properties->name;
 	}
 	// ... but if it did, it must match the one its heartbeat advertized (if any)
 	else
 	{
-		if (server->hb_properties != NULL &&
-			strcmp (value, server->hb_properties->name) != 0)
+		if (hb_properties != NULL &&
+			strcmp (value, hb_properties->name) != 0)
 		{
 			Com_Printf (MSG_WARNING,
 						"> WARNING: invalid infoResponse from %s (game name is different from the one advertized by the heartbeat)\n",
@@ -896,10 +867,41 @@ static void HandleInfoResponse (server_t* server, const char* msg)
 		return;
 	}
 
+	// Get the server in the list. In stateless mode, this is where it gets added
+	server = Sv_GetByAddr (addr, addrlen, stateless_challenges);
+	if (server == NULL)
+	{
+		if (! stateless_challenges)
+			Com_Printf (MSG_WARNING,
+						"> WARNING: infoResponse from unknown server %s\n",
+						peer_address);
+		return;
+	}
+
 	// Save some useful informations in the server entry
 	strncpy (server->gamename, value, sizeof (server->gamename) - 1);
+
+	// Save the values used by the infostring filters
+	value = SearchInfostring (msg, "mapname");
+	strncpy (new_mapname, (value != NULL ? value : ""), sizeof (new_mapname) - 1);
+	new_mapname[sizeof (new_mapname) - 1] = '\0';
+	value = SearchInfostring (msg, "hostname");
+	strncpy (new_hostname, (value != NULL ? value : ""), sizeof (new_hostname) - 1);
+	new_hostname[sizeof (new_hostname) - 1] = '\0';
+
+	info.mapname = new_mapname;
+	info.hostname = new_hostname;
+	info.clients = new_clients;
+	info.maxclients = new_maxclients;
+	value = SearchInfostring (msg, "hc");
+	info.hardcore = (value != NULL && atoi (value) != 0);
+	value = SearchInfostring (msg, "pswrd");
+	info.password = (value != NULL && atoi (value) != 0);
+	Sv_SetInfo (server, &info);
+
 	server->protocol = new_protocol;
-	server->anon_properties = server->hb_properties;
+	server->anon_properties = hb_properties;
+	server->user.altPort = alt_port;
 	strncpy (server->gametype, new_gametype, sizeof (server->gametype) - 1);
 	if (new_clients == 0)
 		server->state = sv_state_empty;
@@ -943,20 +945,9 @@ void HandleMessage (const char* msg, size_t length,
 	// If it's an infoResponse message
 	else if (!strncmp (S2M_INFORESPONSE, msg, strlen (S2M_INFORESPONSE)))
 	{
-		server_t* server;
-
 		Com_Printf (MSG_NORMAL, "> %s ---> infoResponse\n", peer_address);
-	
-		server = Sv_GetByAddr (address, addrlen, false);
-		if (server == NULL)
-		{
-			Com_Printf (MSG_WARNING,
-						"> WARNING: infoResponse from unknown server %s\n",
-						peer_address);
-			return;
-		}
 
-		HandleInfoResponse (server, msg + strlen (S2M_INFORESPONSE));
+		HandleInfoResponse (msg + strlen (S2M_INFORESPONSE), address, addrlen);
 	}
 
 	// If it's a getservers request
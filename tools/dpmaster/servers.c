@@ -31,6 +31,10 @@
 // Timeout for a newly added server (in seconds)
 #define TIMEOUT_HEARTBEAT	2
 
+// Flags of the "info_flags" column
+#define INFO_FLAG_HARDCORE	(1 << 0)
+#define INFO_FLAG_PASSWORD	(1 << 1)
+
 
 // ---------- Private variables ---------- //
 
@@ -53,8 +57,50 @@ static int first_free_slot = 0;  // -1 = no more room
 static int crt_server_ind = -1;
 static int last_server_ind = -1;
 
-// List of address mappings. They are sorted by "from" field (IP, then port)
+// List of address mappings
 static addrmap_t* addrmaps = NULL;
+static unsigned int nb_addrmaps = 0;
+
+// Lookup index of the address mappings. Host mappings are stored in a hash
+// table (open addressing) keyed by their address and port (0 = any port),
+// and subnet mappings in a binary trie of the address bits (node 0 = root).
+// Neither lookup depends on the number of mappings.
+typedef struct
+{
+	unsigned int children [2];		// 0 = no child
+	const addrmap_t* addrmap;
+} addrmap_node_t;
+static const addrmap_t** addrmap_hash = NULL;
+static unsigned int addrmap_hash_mask = 0;
+static addrmap_node_t* addrmap_trie = NULL;
+static unsigned int addrmap_trie_size = 0;
+
+// Should we resolve the address mappings again?
+static volatile sig_atomic_t must_reload_addrmaps = false;
+
+// Infostring values of the servers. They are stored by column, in arrays
+// indexed like "servers", so filtering a request only touches the columns
+// it uses instead of the whole server structures
+static char (*info_mapnames) [MAPNAME_LENGTH] = NULL;
+static unsigned int* info_hostname_hashes = NULL;
+static unsigned short* info_clients = NULL;
+static unsigned short* info_maxclients = NULL;
+static qbyte* info_flags = NULL;
+
+// Names of the infostring fields usable in filters
+static const struct
+{
+	const char* name;
+	server_info_field_t field;
+} info_fields [] =
+{
+	{ "mapname",		sv_info_mapname },
+	{ "hostname",		sv_info_hostname },
+	{ "clients",		sv_info_clients },
+	{ "sv_maxclients",	sv_info_maxclients },
+	{ "hc",			sv_info_hardcore },
+	{ "pswrd",		sv_info_password },
+};
 
 
 // ---------- Public variables ---------- //
@@ -294,27 +340,65 @@ static qboolean Sv_ResolveIPv4Addr (const char* name, struct sockaddr_in* addr)
 
 /*
 ====================
-Sv_InsertAddrmapIntoList
+Sv_AddrmapHash
 
-Insert an addrmap structure to the addrmaps list
+Compute the index of a host mapping in the address mapping hash table
 ====================
 */
-static qboolean Sv_InsertAddrmapIntoList (addrmap_t* new_map)
+static unsigned int Sv_AddrmapHash (unsigned int addr, unsigned short port)
 {
-	addrmap_t* addrmap = addrmaps;
-	addrmap_t** prev = &addrmaps;
-	char from_addr [16];
+	unsigned int hash = addr * 2654435761U;
+
+	hash ^= (unsigned int)port * 40503U;
+	hash ^= hash >> 16;
+
+	return hash & addrmap_hash_mask;
+}
+
 
-	// Stop at the end of the list, or if the addresses become too high
-	while (addrmap != NULL &&
-		   addrmap->from.sin_addr.s_addr <= new_map->from.sin_addr.s_addr)
+/*
+====================
+Sv_FreeAddrmapIndex
+
+Free the lookup index of the address mappings
+====================
+*/
+static void Sv_FreeAddrmapIndex (void)
+{
+	free ((void*)addrmap_hash);
+	addrmap_hash = NULL;
+	addrmap_hash_mask = 0;
+
+	free (addrmap_trie);
+	addrmap_trie = NULL;
+	addrmap_trie_size = 0;
+}
+
+
+/*
+====================
+Sv_IndexAddrmap
+
+Insert an address mapping into the lookup index
+====================
+*/
+static qboolean Sv_IndexAddrmap (const addrmap_t* new_map)
+{
+	unsigned int from_addr = ntohl (new_map->from.sin_addr.s_addr);
+	char from_addr_string [16];
+
+	// Host mapping
+	if (new_map->from_prefix_len == 32)
 	{
-		// If we found the right place
-		if (addrmap->from.sin_addr.s_addr == new_map->from.sin_addr.s_addr &&
-			addrmap->from.sin_port >= new_map->from.sin_port)
+		unsigned int ind = Sv_AddrmapHash (from_addr, new_map->from.sin_port);
+
+		while (addrmap_hash[ind] != NULL)
 		{
+			const addrmap_t* addrmap = addrmap_hash[ind];
+
 			// If a mapping is already recorded for this address
-			if (addrmap->from.sin_port == new_map->from.sin_port)
+			if (addrmap->from.sin_addr.s_addr == new_map->from.sin_addr.s_addr &&
+				addrmap->from.sin_port == new_map->from.sin_port)
 			{
 				Com_Printf (MSG_ERROR,
 							"> ERROR: several mappings are declared for address %s:%hu\n",
@@ -322,25 +406,110 @@ static qboolean Sv_InsertAddrmapIntoList (addrmap_t* new_map)
 							ntohs (new_map->from.sin_port));
 				return false;
 			}
-			break;
+
+			ind = (ind + 1) & addrmap_hash_mask;
 		}
 
-		prev = &addrmap->next;
-		addrmap = addrmap->next;
+		addrmap_hash[ind] = new_map;
 	}
 
-	// Insert it
-	new_map->next = *prev;
-	*prev = new_map;
+	// Subnet mapping
+	else
+	{
+		unsigned int node = 0;
+		unsigned int depth;
+
+		for (depth = 0; depth < new_map->from_prefix_len; depth++)
+		{
+			unsigned int bit = (from_addr >> (31 - depth)) & 1;
+
+			if (addrmap_trie[node].children[bit] == 0)
+			{
+				unsigned int new_node = addrmap_trie_size++;
+
+				memset (&addrmap_trie[new_node], 0, sizeof (addrmap_trie[new_node]));
+				addrmap_trie[node].children[bit] = new_node;
+			}
+			node = addrmap_trie[node].children[bit];
+		}
+
+		// If a mapping is already recorded for this subnet
+		if (addrmap_trie[node].addrmap != NULL)
+		{
+			Com_Printf (MSG_ERROR,
+						"> ERROR: several mappings are declared for subnet %s/%u\n",
+						inet_ntoa (new_map->from.sin_addr),
+						new_map->from_prefix_len);
+			return false;
+		}
+
+		addrmap_trie[node].addrmap = new_map;
+	}
+
+	strncpy (from_addr_string, inet_ntoa (new_map->from.sin_addr), sizeof(from_addr_string) - 1);
+	from_addr_string[sizeof(from_addr_string) - 1] = '\0';
+	if (new_map->from_prefix_len == 32)
+		Com_Printf (MSG_NORMAL, "> Address \"%s\" (%s:%hu) mapped to \"%s\" (%s:%hu)\n",
+					new_map->from_string,
+					from_addr_string, ntohs (new_map->from.sin_port),
+					new_map->to_string,
+					inet_ntoa (new_map->to.sin_addr), ntohs (new_map->to.sin_port));
+	else
+		Com_Printf (MSG_NORMAL, "> Subnet \"%s\" (%s/%u) mapped to \"%s\" (%s:%hu)\n",
+					new_map->from_string,
+					from_addr_string, new_map->from_prefix_len,
+					new_map->to_string,
+					inet_ntoa (new_map->to.sin_addr), ntohs (new_map->to.sin_port));
 
-	strncpy (from_addr, inet_ntoa (new_map->from.sin_addr), sizeof(from_addr) - 1);
-	from_addr[sizeof(from_addr) - 1] = '\0';
-	Com_Printf (MSG_NORMAL, "> Address \"%s\" (%s:%hu) mapped to \"%s\" (%s:%hu)\n",
-				new_map->from_string,
-				from_addr, ntohs (new_map->from.sin_port),
-				new_map->to_string,
-				inet_ntoa (new_map->to.sin_addr), ntohs (new_map->to.sin_port));
-	
+	return true;
+}
+
+
+/*
+====================
+Sv_BuildAddrmapIndex
+
+Build the lookup index of the address mappings
+====================
+*/
+static qboolean Sv_BuildAddrmapIndex (void)
+{
+	const addrmap_t* addrmap;
+	unsigned int hash_size = 1;
+	unsigned int max_trie_size = 1;
+
+	Sv_FreeAddrmapIndex ();
+
+	// Keep the hash table at most half full, and count the trie nodes we may need
+	while (hash_size < nb_addrmaps * 2)
+		hash_size <<= 1;
+	for (addrmap = addrmaps; addrmap != NULL; addrmap = addrmap->next)
+		if (addrmap->from_prefix_len < 32)
+			max_trie_size += addrmap->from_prefix_len;
+
+	addrmap_hash = malloc (hash_size * sizeof (addrmap_hash[0]));
+	addrmap_trie = malloc (max_trie_size * sizeof (addrmap_trie[0]));
+	if (addrmap_hash == NULL || addrmap_trie == NULL)
+	{
+		Com_Printf (MSG_ERROR,
+					"> ERROR: can't allocate the address mapping index (%s)\n",
+					strerror (errno));
+		Sv_FreeAddrmapIndex ();
+		return false;
+	}
+	memset ((void*)addrmap_hash, 0, hash_size * sizeof (addrmap_hash[0]));
+	addrmap_hash_mask = hash_size - 1;
+	memset (&addrmap_trie[0], 0, sizeof (addrmap_trie[0]));
+	addrmap_trie_size = 1;
+
+	for (addrmap = addrmaps; addrmap != NULL; addrmap = addrmap->next)
+		if (! Sv_IndexAddrmap (addrmap))
+		{
+			Sv_FreeAddrmapIndex ();
+			return false;
+		}
+
+	assert (addrmap_trie_size <= max_trie_size);
 	return true;
 }
 
@@ -354,31 +523,59 @@ Look for an address mapping corresponding to addr
 */
 static const addrmap_t* Sv_GetAddrmap (const struct sockaddr_in* addr)
 {
-	const addrmap_t* addrmap = addrmaps;
+	unsigned int host_addr;
 	const addrmap_t* found = NULL;
+	unsigned int node, depth;
+
+	if (nb_addrmaps == 0 || addrmap_hash == NULL)
+		return NULL;
+
+	host_addr = ntohl (addr->sin_addr.s_addr);
 
-	// Stop at the end of the list, or if the addresses become too high
-	while (addrmap != NULL &&
-		   addrmap->from.sin_addr.s_addr <= addr->sin_addr.s_addr)
+	// Exact address and port, then exact address with any port
+	if (addr->sin_port != 0)
 	{
-		// If it's the right address
-		if (addrmap->from.sin_addr.s_addr == addr->sin_addr.s_addr)
+		unsigned int ind = Sv_AddrmapHash (host_addr, addr->sin_port);
+
+		while (addrmap_hash[ind] != NULL)
 		{
-			// If the exact mapping isn't there
-			if (addrmap->from.sin_port > addr->sin_port)
-				return found;
+			const addrmap_t* addrmap = addrmap_hash[ind];
 
-			// If we found the exact address
-			if (addrmap->from.sin_port == addr->sin_port)
+			if (addrmap->from.sin_addr.s_addr == addr->sin_addr.s_addr &&
+				addrmap->from.sin_port == addr->sin_port)
 				return addrmap;
 
-			// General mapping
-			// Store it in case we don't find the exact address mapping
-			if (addrmap->from.sin_port == 0)
-				found = addrmap;
+			ind = (ind + 1) & addrmap_hash_mask;
 		}
+	}
+	{
+		unsigned int ind = Sv_AddrmapHash (host_addr, 0);
+
+		while (addrmap_hash[ind] != NULL)
+		{
+			const addrmap_t* addrmap = addrmap_hash[ind];
+
+			if (addrmap->from.sin_addr.s_addr == addr->sin_addr.s_addr &&
+				addrmap->from.sin_port == 0)
+				return addrmap;
 
-		addrmap = addrmap->next;
+			ind = (ind + 1) & addrmap_hash_mask;
+		}
+	}
+
+	// Longest matching subnet
+	node = 0;
+	found = addrmap_trie[0].addrmap;
+	for (depth = 0; depth < 32; depth++)
+	{
+		unsigned int bit = (host_addr >> (31 - depth)) & 1;
+
+		node = addrmap_trie[node].children[bit];
+		if (node == 0)
+			break;
+
+		if (addrmap_trie[node].addrmap != NULL)
+			found = addrmap_trie[node].addrmap;
 	}
 
 	return found;
@@ -394,11 +591,63 @@ Resolve an addrmap structure and check the parameters validity
 */
 static qboolean Sv_ResolveAddrmap (addrmap_t* addrmap)
 {
+	const char* from_string = addrmap->from_string;
+	char* from_copy = NULL;
+	char* prefix_ptr;
+	qboolean resolved;
+
+	// Extract the prefix length of a subnet, if any
+	addrmap->from_prefix_len = 32;
+	prefix_ptr = strchr (from_string, '/');
+	if (prefix_ptr != NULL)
+	{
+		char* end_ptr;
+		unsigned long prefix_len;
+
+		prefix_len = strtoul (prefix_ptr + 1, &end_ptr, 10);
+		if (end_ptr == prefix_ptr + 1 || *end_ptr != '\0' || prefix_len > 32)
+		{
+			Com_Printf (MSG_ERROR, "> ERROR: invalid subnet %s\n", from_string);
+			return false;
+		}
+		addrmap->from_prefix_len = (unsigned int)prefix_len;
+
+		from_copy = strdup (from_string);
+		if (from_copy == NULL)
+		{
+			Com_Printf (MSG_ERROR,
+						"> ERROR: can't allocate enough memory to resolve %s\n",
+						from_string);
+			return false;
+		}
+		from_copy[prefix_ptr - from_string] = '\0';
+		from_string = from_copy;
+	}
+
 	// Resolve the addresses
-	if (!Sv_ResolveIPv4Addr (addrmap->from_string, &addrmap->from) ||
-		!Sv_ResolveIPv4Addr (addrmap->to_string, &addrmap->to))
+	resolved = (Sv_ResolveIPv4Addr (from_string, &addrmap->from) &&
+				Sv_ResolveIPv4Addr (addrmap->to_string, &addrmap->to));
+	free (from_copy);
+	if (! resolved)
 		return false;
 
+	if (addrmap->from_prefix_len < 32)
+	{
+		unsigned int mask;
+
+		// Subnets apply to every port
+		if (addrmap->from.sin_port != 0)
+		{
+			Com_Printf (MSG_ERROR,
+						"> ERROR: Mapping from a subnet can't specify a port\n");
+			return false;
+		}
+
+		// Clear the host part of the subnet address
+		mask = (addrmap->from_prefix_len == 0 ? 0 : 0xFFFFFFFFU << (32 - addrmap->from_prefix_len));
+		addrmap->from.sin_addr.s_addr = htonl (ntohl (addrmap->from.sin_addr.s_addr) & mask);
+	}
+
 	// 0.0.0.0 addresses are forbidden
 	if (addrmap->from.sin_addr.s_addr == 0 ||
 		addrmap->to.sin_addr.s_addr == 0)
@@ -420,6 +669,74 @@ static qboolean Sv_ResolveAddrmap (addrmap_t* addrmap)
 }
 
 
+/*
+====================
+Sv_HashInfoString
+
+Compute the hash of an infostring value (case insensitive)
+====================
+*/
+static unsigned int Sv_HashInfoString (const char* string)
+{
+	unsigned int hash = 2166136261U;
+
+	while (*string != '\0')
+	{
+		hash ^= (unsigned char)tolower ((unsigned char)*string++);
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+
+/*
+====================
+Sv_ClearInfo
+
+Reset the infostring values of a server slot
+====================
+*/
+static void Sv_ClearInfo (unsigned int sv_ind)
+{
+	info_mapnames[sv_ind][0] = '\0';
+	info_hostname_hashes[sv_ind] = 0;
+	info_clients[sv_ind] = 0;
+	info_maxclients[sv_ind] = 0;
+	info_flags[sv_ind] = 0;
+}
+
+
+/*
+====================
+Sv_CompareNumbers
+
+Apply a filter operator to 2 numbers
+====================
+*/
+static qboolean Sv_CompareNumbers (server_filter_op_t op, unsigned int sv_value, unsigned int filter_value)
+{
+	switch (op)
+	{
+		case sv_filter_eq:
+			return (sv_value == filter_value);
+		case sv_filter_ne:
+			return (sv_value != filter_value);
+		case sv_filter_lt:
+			return (sv_value < filter_value);
+		case sv_filter_le:
+			return (sv_value <= filter_value);
+		case sv_filter_gt:
+			return (sv_value > filter_value);
+		case sv_filter_ge:
+			return (sv_value >= filter_value);
+		default:
+			assert (false);
+			return false;
+	}
+}
+
+
 // ---------- Public functions (servers) ---------- //
 
 /*
@@ -509,6 +826,21 @@ qboolean Sv_Init (void)
 	if (! Com_UserHashTable_Init (&hash_table, sv_hash_size, "server"))
 		return false;
 
+	// Allocate the infostring columns
+	info_mapnames = malloc (max_nb_servers * sizeof (info_mapnames[0]));
+	info_hostname_hashes = malloc (max_nb_servers * sizeof (info_hostname_hashes[0]));
+	info_clients = malloc (max_nb_servers * sizeof (info_clients[0]));
+	info_maxclients = malloc (max_nb_servers * sizeof (info_maxclients[0]));
+	info_flags = malloc (max_nb_servers * sizeof (info_flags[0]));
+	if (info_mapnames == NULL || info_hostname_hashes == NULL ||
+		info_clients == NULL || info_maxclients == NULL || info_flags == NULL)
+	{
+		Com_Printf (MSG_ERROR,
+					"> ERROR: can't allocate the server infos arrays (%s)\n",
+					  strerror (errno));
+		return false;
+	}
+
 	return true;
 }
 
@@ -625,6 +957,7 @@ server_t* Sv_GetByAddr (const struct sockaddr_storage* address, socklen_t addrle
 	memcpy (&sv->user.address, address, sizeof (sv->user.address));
 	sv->user.addrlen = addrlen;
 	sv->addrmap = addrmap;
+	Sv_ClearInfo ((unsigned int)(sv - servers));
 
 	// Add it to the list it belongs to
 	hash = Com_AddressHash (address, sv_hash_size);
@@ -753,13 +1086,201 @@ void Sv_PrintServerList (msg_level_t msg_level)
 			Com_Printf (msg_level,
 						" (timeout: %lu)\n"
 						"\tgame: \"%s\" (protocol: %d, gametype: %s)\n"
-						"\tstate: %s\n"
-						"\tchallenge: \"%s\" (timeout: %lu)\n",
+						"\tstate: %s\n",
 						(unsigned long)sv->timeout,
 						sv->gamename, sv->protocol, sv->gametype,
-						state_string,
-						sv->challenge, (unsigned long)sv->challenge_timeout);
+						state_string);
+
+			if (sv->state > sv_state_uninitialized)
+				Com_Printf (msg_level,
+							"\tinfos: map \"%s\", clients: %hu/%hu, hardcore: %d, password: %d\n",
+							info_mapnames[ind], info_clients[ind], info_maxclients[ind],
+							(info_flags[ind] & INFO_FLAG_HARDCORE) != 0,
+							(info_flags[ind] & INFO_FLAG_PASSWORD) != 0);
+		}
+}
+
+
+// ---------- Public functions (server infos) ---------- //
+
+/*
+====================
+Sv_SetInfo
+
+Save the infostring values of a server
+====================
+*/
+void Sv_SetInfo (const server_t* sv, const server_info_t* info)
+{
+	unsigned int sv_ind = (unsigned int)(sv - servers);
+	qbyte flags = 0;
+
+	assert (sv_ind < max_nb_servers);
+
+	strncpy (info_mapnames[sv_ind], info->mapname, sizeof (info_mapnames[sv_ind]) - 1);
+	info_mapnames[sv_ind][sizeof (info_mapnames[sv_ind]) - 1] = '\0';
+	info_hostname_hashes[sv_ind] = Sv_HashInfoString (info->hostname);
+	info_clients[sv_ind] = (unsigned short)(info->clients > USHRT_MAX ? USHRT_MAX : info->clients);
+	info_maxclients[sv_ind] = (unsigned short)(info->maxclients > USHRT_MAX ? USHRT_MAX : info->maxclients);
+
+	if (info->hardcore)
+		flags |= INFO_FLAG_HARDCORE;
+	if (info->password)
+		flags |= INFO_FLAG_PASSWORD;
+	info_flags[sv_ind] = flags;
+}
+
+
+/*
+====================
+Sv_ParseFilter
+
+Parse a filter expression of the form "<field><operator><value>"
+====================
+*/
+qboolean Sv_ParseFilter (const char* expression, server_filter_t* filter)
+{
+	size_t name_len;
+	const char* value;
+	unsigned int ind;
+
+	// Find the field
+	name_len = strcspn (expression, "=!<>");
+	for (ind = 0; ind < sizeof (info_fields) / sizeof (info_fields[0]); ind++)
+		if (strlen (info_fields[ind].name) == name_len &&
+			strncmp (info_fields[ind].name, expression, name_len) == 0)
+			break;
+	if (ind == sizeof (info_fields) / sizeof (info_fields[0]))
+		return false;
+	filter->field = info_fields[ind].field;
+
+	// Read the operator
+	value = expression + name_len;
+	if (strncmp (value, "!=", 2) == 0)
+	{
+		filter->op = sv_filter_ne;
+		value += 2;
+	}
+	else if (strncmp (value, "<=", 2) == 0)
+	{
+		filter->op = sv_filter_le;
+		value += 2;
+	}
+	else if (strncmp (value, ">=", 2) == 0)
+	{
+		filter->op = sv_filter_ge;
+		value += 2;
+	}
+	else if (*value == '<')
+	{
+		filter->op = sv_filter_lt;
+		value++;
+	}
+	else if (*value == '>')
+	{
+		filter->op = sv_filter_gt;
+		value++;
+	}
+	else if (*value == '=')
+	{
+		filter->op = sv_filter_eq;
+		value++;
+	}
+	else
+		return false;
+
+	// Read the value
+	switch (filter->field)
+	{
+		case sv_info_mapname:
+		case sv_info_hostname:
+			// Strings can only be compared for (in)equality
+			if (filter->op != sv_filter_eq && filter->op != sv_filter_ne)
+				return false;
+
+			if (filter->field == sv_info_mapname)
+			{
+				if (strlen (value) >= sizeof (filter->string))
+					return false;
+				strcpy (filter->string, value);
+			}
+			else
+				filter->value = Sv_HashInfoString (value);
+			break;
+
+		default:
+		{
+			char* end_ptr;
+
+			filter->value = (unsigned int)strtoul (value, &end_ptr, 10);
+			if (end_ptr == value || *end_ptr != '\0')
+				return false;
+			break;
 		}
+	}
+
+	return true;
+}
+
+
+/*
+====================
+Sv_MatchFilters
+
+Return "true" if the server infos match all the filters
+====================
+*/
+qboolean Sv_MatchFilters (const server_t* sv, const server_filter_t* filters, unsigned int nb_filters)
+{
+	unsigned int sv_ind = (unsigned int)(sv - servers);
+	unsigned int ind;
+
+	assert (sv_ind < max_nb_servers);
+
+	for (ind = 0; ind < nb_filters; ind++)
+	{
+		const server_filter_t* filter = &filters[ind];
+		qboolean match;
+
+		switch (filter->field)
+		{
+			case sv_info_mapname:
+				match = (strcasecmp (info_mapnames[sv_ind], filter->string) == 0);
+				if (filter->op == sv_filter_ne)
+					match = ! match;
+				break;
+
+			case sv_info_hostname:
+				match = Sv_CompareNumbers (filter->op, info_hostname_hashes[sv_ind], filter->value);
+				break;
+
+			case sv_info_clients:
+				match = Sv_CompareNumbers (filter->op, info_clients[sv_ind], filter->value);
+				break;
+
+			case sv_info_maxclients:
+				match = Sv_CompareNumbers (filter->op, info_maxclients[sv_ind], filter->value);
+				break;
+
+			case sv_info_hardcore:
+				match = Sv_CompareNumbers (filter->op, (info_flags[sv_ind] & INFO_FLAG_HARDCORE) != 0, filter->value);
+				break;
+
+			case sv_info_password:
+				match = Sv_CompareNumbers (filter->op, (info_flags[sv_ind] & INFO_FLAG_PASSWORD) != 0, filter->value);
+				break;
+
+			default:
+				assert (false);
+				match = false;
+				break;
+		}
+
+		if (! match)
+			return false;
+	}
+
+	return true;
 }
 
 
@@ -824,6 +1345,7 @@ qboolean Sv_AddAddressMapping (const char* mapping)
 	// Add it on top of "addrmaps"
 	addrmap->next = addrmaps;
 	addrmaps = addrmap;
+	nb_addrmaps++;
 
 	return true;
 }
@@ -833,7 +1355,7 @@ qboolean Sv_AddAddressMapping (const char* mapping)
 ====================
 Sv_ResolveAddressMappings
 
-Resolve the address mapping list
+Resolve the address mapping list and build its lookup index
 ====================
 */
 qboolean Sv_ResolveAddressMappings (void)
@@ -844,19 +1366,73 @@ qboolean Sv_ResolveAddressMappings (void)
 	for (addrmap = addrmaps; addrmap != NULL; addrmap = addrmap->next)
 		if (!Sv_ResolveAddrmap (addrmap))
 			return false;
-	
-	// Build the sorted list
-	addrmap = addrmaps;
-	addrmaps = NULL;
-	while (addrmap != NULL)
+
+	return Sv_BuildAddrmapIndex ();
+}
+
+
+/*
+====================
+Sv_RequestAddressMappingsReload
+
+Ask for the address mappings to be resolved again (safe to call from a signal handler)
+====================
+*/
+void Sv_RequestAddressMappingsReload (void)
+{
+	must_reload_addrmaps = true;
+}
+
+
+/*
+====================
+Sv_UpdateAddressMappings
+
+Resolve the address mappings again if it has been requested.
+If anything goes wrong, the previous mappings are kept
+====================
+*/
+void Sv_UpdateAddressMappings (void)
+{
+	addrmap_t* old_maps;
+	addrmap_t* addrmap;
+	unsigned int ind;
+	qboolean success;
+
+	if (! must_reload_addrmaps)
+		return;
+	must_reload_addrmaps = false;
+
+	if (nb_addrmaps == 0)
+		return;
+
+	Com_Printf (MSG_NORMAL, "> Reloading the address mappings\n");
+
+	// Save the current mappings, in case we have to restore them
+	old_maps = malloc (nb_addrmaps * sizeof (old_maps[0]));
+	if (old_maps == NULL)
 	{
-		addrmap_t* next_addrmap = addrmap->next;
-		
-		if (! Sv_InsertAddrmapIntoList (addrmap))
-			return false;
+		Com_Printf (MSG_ERROR,
+					"> ERROR: can't allocate enough memory to reload the address mappings\n");
+		return;
+	}
+	for (addrmap = addrmaps, ind = 0; addrmap != NULL; addrmap = addrmap->next, ind++)
+		old_maps[ind] = *addrmap;
+
+	success = Sv_ResolveAddressMappings ();
+	if (! success)
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: keeping the previous address mappings\n");
 
-		addrmap = next_addrmap;
+		for (addrmap = addrmaps, ind = 0; addrmap != NULL; addrmap = addrmap->next, ind++)
+			*addrmap = old_maps[ind];
+		if (! Sv_BuildAddrmapIndex ())
+			Com_Printf (MSG_ERROR, "> ERROR: the address mappings are now disabled\n");
 	}
+	free (old_maps);
 
-	return true;
+	// Update the mapping of every registered IPv4 server
+	for (ind = 0; (int)ind <= last_used_slot; ind++)
+		if (Sv_IsActive (ind) && servers[ind].user.address.ss_family == AF_INET)
+			servers[ind].addrmap = Sv_GetAddrmap ((const struct sockaddr_in*)&servers[ind].user.address);
 }
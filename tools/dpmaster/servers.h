@@ -36,16 +36,18 @@
 // Address hash size in bits for servers (between 0 and MAX_HASH_SIZE)
 #define DEFAULT_SV_HASH_SIZE 10
 
-// Number of characters in a challenge, including the '\0'
-#define CHALLENGE_MIN_LENGTH 9
-#define CHALLENGE_MAX_LENGTH 12
-
 // Max number of characters for a gamename, including the '\0'
 #define GAMENAME_LENGTH 64
 
 // Max number of characters for a gametype, including the '\0'
 #define GAMETYPE_LENGTH 32
 
+// Max number of characters for a map name, including the '\0'
+#define MAPNAME_LENGTH 32
+
+// Maximum number of infostring filters in a getserversExt request
+#define MAX_INFO_FILTERS 8
+
 
 // ---------- Types ---------- //
 
@@ -55,6 +57,7 @@ typedef struct addrmap_s
 	struct addrmap_s* next;
 	struct sockaddr_in from;
 	struct sockaddr_in to;
+	unsigned int from_prefix_len;	// 32 for a single host, less for a subnet
 	char* from_string;
 	char* to_string;
 } addrmap_t;
@@ -76,16 +79,55 @@ typedef struct server_s
 	user_t user;										// WARNING: MUST be the 1st member, for compatibility with the user hash tables
 	const struct addrmap_s* addrmap;
 	const struct game_properties_s* anon_properties;	// game properties, for an anonymous game
-	const struct game_properties_s* hb_properties;		// future "anon_properties", not yet validated by an infoResponse
 	time_t timeout;
-	time_t challenge_timeout;
 	int protocol;
 	server_state_t state;
-	char challenge [CHALLENGE_MAX_LENGTH];
 	char gametype [GAMETYPE_LENGTH];
 	char gamename [GAMENAME_LENGTH];
 } server_t;
 
+// Infostring values of a server, as parsed from its last infoResponse
+typedef struct
+{
+	const char* mapname;
+	const char* hostname;
+	unsigned int clients;
+	unsigned int maxclients;
+	qboolean hardcore;
+	qboolean password;
+} server_info_t;
+
+// Infostring fields which can be used in a filter
+typedef enum
+{
+	sv_info_mapname,
+	sv_info_hostname,
+	sv_info_clients,
+	sv_info_maxclients,
+	sv_info_hardcore,
+	sv_info_password,
+} server_info_field_t;
+
+// Comparison operators of a filter
+typedef enum
+{
+	sv_filter_eq,
+	sv_filter_ne,
+	sv_filter_lt,
+	sv_filter_le,
+	sv_filter_gt,
+	sv_filter_ge,
+} server_filter_op_t;
+
+// Infostring filter (ex: "mapname=mp_dome", "clients>=4")
+typedef struct
+{
+	server_info_field_t field;
+	server_filter_op_t op;
+	unsigned int value;					// number, or string hash for the hostname
+	char string [MAPNAME_LENGTH];		// map name
+} server_filter_t;
+
 
 // ---------- Public variables ---------- //
 
@@ -117,17 +159,36 @@ server_t* Sv_GetNext (void);
 void Sv_PrintServerList (msg_level_t msg_level);
 
 
+// ---------- Public functions (server infos) ---------- //
+
+// Save the infostring values of a server
+void Sv_SetInfo (const server_t* sv, const server_info_t* info);
+
+// Parse a filter expression of the form "<field><operator><value>"
+qboolean Sv_ParseFilter (const char* expression, server_filter_t* filter);
+
+// Return "true" if the server infos match all the filters
+qboolean Sv_MatchFilters (const server_t* sv, const server_filter_t* filters, unsigned int nb_filters);
+
+
 // ---------- Public functions (address mappings) ---------- //
 
 // NOTE: this is a 2-step process because resolving address mappings directly
 // during the parsing of the command line would cause several problems
 
 // Add an unresolved address mapping to the list
-// mapping must be of the form "addr1:port1=addr2:port2", ":portX" are optional
+// mapping must be of the form "addr1:port1=addr2:port2", ":portX" are optional.
+// "addr1" can also be a subnet of the form "addr/prefix_length", without port
 qboolean Sv_AddAddressMapping (const char* mapping);
 
-// Resolve the address mapping list
+// Resolve the address mapping list and build its lookup index
 qboolean Sv_ResolveAddressMappings (void);
 
+// Ask for the address mappings to be resolved again (safe to call from a signal handler)
+void Sv_RequestAddressMappingsReload (void);
+
+// Resolve the address mappings again if it has been requested
+void Sv_UpdateAddressMappings (void);
+
 
 #endif  // #ifndef _SERVERS_H_
@@ -21,9 +21,18 @@
 */
 
 
+// Needed for rand_s()
+#ifdef WIN32
+#	define _CRT_RAND_S
+#endif
+
 #include "common.h"
 #include "system.h"
 
+#ifndef WIN32
+#	include <pthread.h>
+#endif
+
 
 // ---------- Constants ---------- //
 
@@ -51,8 +60,15 @@ static const char* low_priv_user = DEFAULT_LOW_PRIV_USER;
 // File descriptor to /dev/null, used by the daemonization process
 static int null_device = -1;
 
+// File descriptor to /dev/urandom, used by Sys_GetRandomBytes
+static int random_device = -1;
+
 #endif
 
+// Function and parameter of the thread started by Sys_CreateThread
+static void (* volatile new_thread_func) (void* arg) = NULL;
+static void* new_thread_arg = NULL;
+
 
 // ---------- Public variables ---------- //
 
@@ -114,6 +130,36 @@ daemon_state_t daemon_state = DAEMON_STATE_NO;
 
 // ---------- Private functions ---------- //
 
+/*
+====================
+Sys_ThreadEntry
+
+Entry point of the threads started by Sys_CreateThread
+====================
+*/
+#ifdef WIN32
+static DWORD WINAPI Sys_ThreadEntry (LPVOID param)
+#else
+static void* Sys_ThreadEntry (void* param)
+#endif
+{
+	void (*thread_func) (void* arg) = new_thread_func;
+	void* arg = new_thread_arg;
+
+	// Let Sys_CreateThread know we've read our parameters
+	Sys_MemoryBarrier ();
+	new_thread_func = NULL;
+
+	thread_func (arg);
+
+#ifdef WIN32
+	return 0;
+#else
+	return NULL;
+#endif
+}
+
+
 /*
 ====================
 Sys_CloseSocket
@@ -557,6 +603,14 @@ qboolean Sys_SecurityInit (void)
 		}
 	}
 
+	// Same thing for /dev/urandom, which we need for the challenge secrets
+	random_device = open ("/dev/urandom", O_RDONLY, 0);
+	if (random_device == -1)
+	{
+		Com_Printf (MSG_ERROR, "> ERROR: can't open /dev/urandom\n");
+		return false;
+	}
+
 	// UNIX allows us to be completely paranoid, so let's go for it
 	if (geteuid () == 0)
 	{
@@ -771,3 +825,136 @@ const char* Sys_GetLastNetErrorString (void)
 	}
 #endif
 }
+
+
+/*
+====================
+Sys_GetRandomBytes
+
+Fill a buffer with cryptographically secure random bytes
+====================
+*/
+qboolean Sys_GetRandomBytes (void* buffer, size_t size)
+{
+#ifdef WIN32
+	qbyte* bytes = buffer;
+
+	while (size > 0)
+	{
+		unsigned int value;
+		size_t copy_size;
+
+		if (rand_s (&value) != 0)
+			return false;
+
+		copy_size = (size < sizeof (value) ? size : sizeof (value));
+		memcpy (bytes, &value, copy_size);
+		bytes += copy_size;
+		size -= copy_size;
+	}
+
+	return true;
+#else
+	qbyte* bytes = buffer;
+
+	assert (random_device != -1);
+
+	while (size > 0)
+	{
+		ssize_t nb_bytes = read (random_device, bytes, size);
+
+		if (nb_bytes <= 0)
+		{
+			if (nb_bytes < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+
+		bytes += nb_bytes;
+		size -= nb_bytes;
+	}
+
+	return true;
+#endif
+}
+
+
+/*
+====================
+Sys_CreateThread
+
+Start a detached thread
+====================
+*/
+qboolean Sys_CreateThread (void (*thread_func) (void* arg), void* arg)
+{
+	assert (new_thread_func == NULL);
+
+	new_thread_func = thread_func;
+	new_thread_arg = arg;
+	Sys_MemoryBarrier ();
+
+#ifdef WIN32
+	{
+		HANDLE thread = CreateThread (NULL, 0, Sys_ThreadEntry, NULL, 0, NULL);
+
+		if (thread == NULL)
+		{
+			new_thread_func = NULL;
+			return false;
+		}
+		CloseHandle (thread);
+	}
+#else
+	{
+		pthread_t thread;
+
+		if (pthread_create (&thread, NULL, Sys_ThreadEntry, NULL) != 0)
+		{
+			new_thread_func = NULL;
+			return false;
+		}
+		pthread_detach (thread);
+	}
+#endif
+
+	// Wait for the thread to read its parameters
+	while (new_thread_func != NULL)
+		Sys_Sleep (1);
+
+	return true;
+}
+
+
+/*
+====================
+Sys_Sleep
+
+Suspend the calling thread for some time
+====================
+*/
+void Sys_Sleep (unsigned int milliseconds)
+{
+#ifdef WIN32
+	Sleep (milliseconds);
+#else
+	usleep (milliseconds * 1000);
+#endif
+}
+
+
+/*
+====================
+Sys_LocalTime
+
+Thread-safe version of localtime()
+====================
+*/
+void Sys_LocalTime (const time_t* time, struct tm* result)
+{
+#ifdef WIN32
+	localtime_s (result, time);
+#else
+	localtime_r (time, result);
+#endif
+}
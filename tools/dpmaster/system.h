@@ -129,6 +129,7 @@ qboolean Sys_CreateListenSockets (void);
 #ifdef WIN32
 # define snprintf _snprintf
 # define strdup _strdup
+# define strcasecmp _stricmp
 #endif
 
 
@@ -156,5 +157,27 @@ int Sys_GetLastNetError (void);
 // Get the last network error string
 const char* Sys_GetLastNetErrorString (void);
 
+// Fill a buffer with cryptographically secure random bytes
+qboolean Sys_GetRandomBytes (void* buffer, size_t size);
+
+
+// ---------- Public functions (threads) ---------- //
+
+// Full memory barrier, for the lock-free structures shared between threads
+#ifdef WIN32
+#	define Sys_MemoryBarrier() MemoryBarrier ()
+#else
+#	define Sys_MemoryBarrier() __sync_synchronize ()
+#endif
+
+// Start a detached thread
+qboolean Sys_CreateThread (void (*thread_func) (void* arg), void* arg);
+
+// Suspend the calling thread for some time
+void Sys_Sleep (unsigned int milliseconds);
+
+// Thread-safe version of localtime()
+void Sys_LocalTime (const time_t* time, struct tm* result);
+
 
 #endif  // #ifndef _SYSTEM_H_